@@ -4,6 +4,7 @@
 #include "structs.h"
 
 void AI_StartThreads(AppState *s);
+void AI_UpdateTargeting(AppState *s);
 void AI_UpdateUnitMovement(AppState *s, int unit_idx, float dt);
 
 #endif
@@ -0,0 +1,64 @@
+#ifndef BITS_H
+#define BITS_H
+
+#include <SDL3/SDL.h>
+#include <stdbool.h>
+
+// Fixed-size bitsets stored as 64-bit words, one bit per pool slot. The pools' active flags,
+// the targeted flags and the selection sets use these, so clears and intersections run a word
+// at a time and scans skip empty words with count-trailing-zeros.
+#define BITS_WORDS(n) (((n) + 63) / 64)
+
+static inline bool Bits_Test(const Uint64 *w, int i) { return (w[i >> 6] >> (i & 63)) & 1; }
+static inline void Bits_Set(Uint64 *w, int i) { w[i >> 6] |= (Uint64)1 << (i & 63); }
+static inline void Bits_Clear(Uint64 *w, int i) { w[i >> 6] &= ~((Uint64)1 << (i & 63)); }
+static inline void Bits_ClearAll(Uint64 *w, int n) { SDL_memset(w, 0, sizeof(Uint64) * BITS_WORDS(n)); }
+
+// Index of the lowest set bit; x must be non-zero
+static inline int Bits_Ctz(Uint64 x) {
+#if defined(_MSC_VER)
+  unsigned long i;
+  _BitScanForward64(&i, x);
+  return (int)i;
+#else
+  return __builtin_ctzll(x);
+#endif
+}
+
+// Lowest set index >= from, or -1. Scans ascend, so BITS_FOR_EACH visits slots in the same
+// order as an index loop testing each flag.
+static inline int Bits_Next(const Uint64 *w, int n, int from) {
+  if (from >= n) return -1;
+  int k = from >> 6;
+  Uint64 m = w[k] & (~(Uint64)0 << (from & 63));
+  while (!m) {
+    if (++k >= BITS_WORDS(n)) return -1;
+    m = w[k];
+  }
+  int i = (k << 6) + Bits_Ctz(m);
+  return i < n ? i : -1;
+}
+
+#define BITS_FOR_EACH(i, w, n) for (int i = Bits_Next((w), (n), 0); i >= 0; i = Bits_Next((w), (n), i + 1))
+
+// Same over the intersection of two sets, e.g. active AND selected
+static inline int Bits_NextAnd(const Uint64 *a, const Uint64 *b, int n, int from) {
+  if (from >= n) return -1;
+  int k = from >> 6;
+  Uint64 m = a[k] & b[k] & (~(Uint64)0 << (from & 63));
+  while (!m) {
+    if (++k >= BITS_WORDS(n)) return -1;
+    m = a[k] & b[k];
+  }
+  int i = (k << 6) + Bits_Ctz(m);
+  return i < n ? i : -1;
+}
+
+#define BITS_FOR_EACH_AND(i, a, b, n) for (int i = Bits_NextAnd((a), (b), (n), 0); i >= 0; i = Bits_NextAnd((a), (b), (n), i + 1))
+
+// dst = a AND b; dst may alias either input
+static inline void Bits_And(Uint64 *dst, const Uint64 *a, const Uint64 *b, int n) {
+  for (int k = 0; k < BITS_WORDS(n); k++) dst[k] = a[k] & b[k];
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include "structs.h"
+
+// Passes queue their structural changes here instead of applying them mid-iteration.
+// Removals skip targets that are already gone, so a pair of duplicate commands is harmless.
+void Commands_SplitAsteroid(AppState *s, int idx);
+// blast adds the ramming blast around the wreck; laser kills pass false
+void Commands_DestroyAsteroid(AppState *s, int idx, bool blast);
+// True from Commands_DestroyAsteroid until the flush that frees the slot
+bool Commands_DestroyPending(const AppState *s, int idx);
+// Explosion with linear falloff; asteroids take half, and it shakes the camera
+void Commands_AreaDamage(AppState *s, Vec2 pos, float range, float damage, int exclude_unit_idx);
+// Full damage anywhere in range, scaled per body kind, without camera shake
+void Commands_FlatDamage(AppState *s, Vec2 pos, float range, float damage, float unit_mult, float asteroid_mult, int exclude_asteroid_idx);
+void Commands_SpawnCrystal(AppState *s, Vec2 pos, Vec2 vel_dir, float radius);
+
+// Applies removals in push order, then all blasts as one batch, then spawns, and empties the queue.
+// Fragments therefore only claim slots after every removal queued by the pass has run.
+void Commands_Flush(AppState *s);
+
+#endif
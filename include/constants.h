@@ -17,6 +17,33 @@
 
 #define EDGE_SCROLL_THRESHOLD 20
 
+// Profiler
+#define PROFILER_HISTORY_FRAMES 240
+#define TRACE_RING_CAPACITY 32768 // Per thread, power of two
+
+// Frame-time statistics
+#define HISTOGRAM_WINDOW 3600 // Samples kept in the rolling window (~1 min at 60 Hz)
+#define HISTOGRAM_SUB_BUCKETS 16 // Linear steps per power of two (~6% precision)
+#define HISTOGRAM_BUCKETS (HISTOGRAM_SUB_BUCKETS * 25) // Covers 1 us up to ~4.5 min
+#define STUTTER_FACTOR 2.0f // Frames longer than this times the median count as stutters
+#define STUTTER_MIN_SAMPLES 120
+#define STUTTER_LOG_FILE "stutter.log"
+
+// Fixed-step simulation
+#define SIM_TICK_RATE 60
+#define RNG_STREAM_SIM 1
+#define RNG_STREAM_VFX 2
+#define SIM_MAX_FRAME_TIME 0.25f // Clamp for hitches so we don't spiral
+
+// Sim worker pool
+#define JOBS_MAX_WORKERS 15 // Plus the sim thread itself
+#ifndef PHYSICS_SIMD
+#define PHYSICS_SIMD 1 // Build with -DPHYSICS_SIMD=0 to solve contacts and integrate particles with the scalar reference only
+#endif
+#ifndef SLOTS_VALIDATE
+#define SLOTS_VALIDATE 0 // Build with -DSLOTS_VALIDATE=1 to check the free-slot stacks against the pools every tick
+#endif
+
 #define MINIMAP_SIZE 200.0f
 #define MINIMAP_MARGIN 20.0f
 #define MINIMAP_RANGE 60000.0f
@@ -37,6 +64,11 @@
 #define RESPAWN_RANGE 5000.0f
 #define RESPAWN_BUFFER 500.0f
 #define DESPAWN_RANGE 16000.0f
+// Simulation tiers by distance to the nearest anchor. Full covers every unit, which sits
+// within DESPAWN_RANGE * 0.5 of an anchor, plus a margin, and the whole view at MIN_ZOOM.
+#define SIM_FULL_RANGE 10000.0f
+#define SIM_DRIFT_RANGE 13000.0f // Beyond this asteroids sleep until an anchor comes near
+#define SIM_DRIFT_STEP 0.1f // Seconds of motion banked between drift updates
 #define MAX_SIM_ANCHORS 8
 #define MAX_ASTEROIDS 2048
 #define MIN_DYNAMIC_ASTEROIDS 0
@@ -79,6 +111,21 @@
 #define ASTEROID_VISUAL_SCALE 1.0f
 #define ASTEROID_CORE_SCALE 0.35f
 
+// Spatial hash broadphase: cells match the mean asteroid hitbox diameter, so most asteroids cover 1-4 cells
+#define SPATIAL_CELL_SIZE ((ASTEROID_BASE_RADIUS_MIN + ASTEROID_BASE_RADIUS_VARIANCE * 0.5f) * ASTEROID_HITBOX_MULT * 2.0f)
+#define SPATIAL_BUCKETS 4096 // Power of two
+#define SPATIAL_MAX_IDS (MAX_ASTEROIDS + MAX_RESOURCES + MAX_UNITS)
+#define SPATIAL_MAX_ENTRIES (SPATIAL_MAX_IDS * 4)
+#define SPATIAL_QUERY_MARGIN 200.0f // Covers one tick of drift for queries made after the grid was built
+#define SWEEP_MAX_PAIRS 16384 // Sweep-and-prune falls back to the grid for a tick that finds more
+#define CONTACT_MAX_PAIRS 32768 // Asteroid pairs per tick; beyond this the pass resolves serially
+#define CONTACT_GATHER_GRAIN 64 // Asteroids per pair-gathering job
+#define CONTACT_SOLVE_GRAIN 32 // Pairs per solve job; smaller batches stay on the sim thread
+#define SWEPT_CONTACT_DEPTH 0.999f // Swept hits rewind to this fraction of r_sum so the discrete solver sees them touching
+#define COLLISION_EVENT_CAP (CONTACT_MAX_PAIRS + MAX_ASTEROIDS + MAX_UNITS * 16 + COMMAND_QUEUE_SIZE) // Batched pairs, swept hits, unit contacts and outcomes per tick
+#define COLLISION_VFX_BUDGET 64 // Split and destruction explosions spawned per tick
+#define COMMAND_QUEUE_SIZE 8192 // Deferred world changes per flush, fragments included; also the blast cap
+
 #define PLANET_VISUAL_SCALE 1.1f
 #define GALAXY_VISUAL_SCALE 1.0f
 #define MOTHERSHIP_VISUAL_SCALE 2.6f
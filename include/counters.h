@@ -0,0 +1,11 @@
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include "structs.h"
+
+bool Counters_Open(AppState *s, const char *filename);
+void Counters_BeginTick(AppState *s);
+void Counters_EndTick(AppState *s, double ms);
+void Counters_Close(AppState *s);
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+
+#include "structs.h"
+
+// Logs the size of AppState and each world pool, plus the tick working set at full capacity and for s's live counts
+void Footprint_LogReport(const AppState *s);
+
+// Bytes the simulation tick reads or writes for the current entity counts (lower bound)
+size_t Footprint_TickWorkingSet(const AppState *s);
+
+#endif
@@ -5,7 +5,10 @@
 
 // System functions
 void Game_Init(AppState *s);
+// Seeds the gameplay and VFX random streams; call before Game_Init
+void Game_Seed(AppState *s, Uint64 seed);
 void Game_Update(AppState *s, float dt);
+void Game_SnapshotState(AppState *s);
 float GetAsteroidDensity(Vec2 p);
 bool GetCelestialBodyInfo(int gx, int gy, Vec2 *out_pos, float *out_type_seed, float *out_radius);
 void SpawnAsteroid(AppState *s, Vec2 pos, Vec2 vel_dir, float radius);
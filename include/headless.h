@@ -0,0 +1,11 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "structs.h"
+
+// Windowless driver for Game_Update (no renderer, no worker threads)
+void Headless_Init(AppState *s, unsigned int seed, int view_w, int view_h);
+void Headless_Step(AppState *s, float dt);
+int Headless_SpawnUnit(AppState *s, UnitType type, Vec2 pos, TacticalBehavior behavior);
+
+#endif
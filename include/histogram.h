@@ -0,0 +1,9 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include "structs.h"
+
+void Histogram_Record(Histogram *h, double ms);
+double Histogram_Percentile(const Histogram *h, double p);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include "structs.h"
+
+// Worker count for this machine: one fewer than the logical cores, capped at JOBS_MAX_WORKERS
+int Jobs_DefaultWorkerCount(void);
+void Jobs_Start(JobPool *p, int worker_count);
+void Jobs_Stop(JobPool *p);
+
+// Runs fn over [0, count) in chunks of grain and returns once every chunk is done.
+// Chunks run in any order on any thread, so fn must only write state owned by its range.
+void Jobs_ParallelFor(JobPool *p, int count, int grain, JobFn fn, void *ctx);
+
+#endif
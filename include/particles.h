@@ -3,9 +3,26 @@
 
 #include "structs.h"
 
+// Vec2 views of the particle motion lanes
+static inline Vec2 Particles_Pos(const AppState *s, int idx) { return (Vec2){s->world.particles.pos_x[idx], s->world.particles.pos_y[idx]}; }
+static inline void Particles_SetPos(AppState *s, int idx, Vec2 pos) {
+  s->world.particles.pos_x[idx] = pos.x;
+  s->world.particles.pos_y[idx] = pos.y;
+}
+static inline void Particles_SetVelocity(AppState *s, int idx, Vec2 velocity) {
+  s->world.particles.vel_x[idx] = velocity.x;
+  s->world.particles.vel_y[idx] = velocity.y;
+}
+
+// Claims a free slot, or overwrites live particles round-robin when the pool is full
+int Particles_Alloc(AppState *s);
+
 // Spawns a visual explosion effect at the given position
 void Particles_SpawnExplosion(AppState *s, Vec2 pos, int count, float size_mult, ExplosionType type, int asteroid_tex_idx);
 
+// Explosions for this tick's asteroid splits and destructions, capped at COLLISION_VFX_BUDGET
+void Particles_SpawnCollisionVfx(AppState *s);
+
 // Spawns a bright laser flash (muzzle or impact)
 void Particles_SpawnLaserFlash(AppState *s, Vec2 pos, float size, SDL_Color color, bool is_impact);
 
@@ -8,6 +8,9 @@
 void Physics_UpdateAsteroids(AppState *s, float dt);
 void Physics_UpdateResources(AppState *s, float dt);
 void Physics_HandleCollisions(AppState *s, float dt);
-void Physics_AreaDamage(AppState *s, Vec2 pos, float range, float damage, int exclude_unit_idx);
+// Appends to this tick's collision events; counts and drops the event once the buffer is full
+void Physics_EmitEvent(AppState *s, CollisionEventType type, int a, int b, Vec2 point, float magnitude, int tex_idx);
+// Sums every blast's damage per target and applies it once, with one camera shake for the batch
+void Physics_ApplyBlasts(AppState *s, const AreaBlast *blasts, int count);
 
 #endif
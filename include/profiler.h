@@ -0,0 +1,21 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "structs.h"
+
+typedef struct {
+    const char *name;
+    ProfileZone parent; // PROF_ZONE_COUNT for the root
+    SDL_Color color;
+} ProfileZoneInfo;
+
+void Profiler_BeginFrame(AppState *s);
+void Profiler_EndFrame(AppState *s);
+void Profiler_Begin(AppState *s, ProfileZone zone);
+void Profiler_End(AppState *s, ProfileZone zone);
+double Profiler_GetZoneMs(const AppState *s, ProfileZone zone);
+float Profiler_GetHistoryMs(const AppState *s, int age, ProfileZone zone);
+const ProfileZoneInfo *Profiler_GetZoneInfo(ProfileZone zone);
+int Profiler_GetZoneDepth(ProfileZone zone);
+
+#endif
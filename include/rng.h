@@ -0,0 +1,12 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include "structs.h"
+
+// PCG32; each stream gives an independent sequence for the same seed
+void Rng_Seed(Rng *r, Uint64 seed, Uint64 stream);
+Uint32 Rng_Next(Rng *r);
+int Rng_Int(Rng *r, int n);   // [0, n), 0 when n <= 0
+float Rng_Float(Rng *r);      // [0, 1)
+
+#endif
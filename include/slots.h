@@ -0,0 +1,41 @@
+#ifndef SLOTS_H
+#define SLOTS_H
+
+#include "structs.h"
+
+// Slot bookkeeping for the entity pools. Claiming a slot pops a free stack instead of scanning
+// from index 0, and each pool keeps a dense list of its live slots so order-independent loops
+// skip the inactive ones. Every spawn and removal goes through these helpers; anything that
+// rewrites a pool wholesale calls Slots_Rebuild afterwards.
+//
+// Live lists are swap-removed, so they are not in slot order. Loops whose result depends on
+// visiting order (AI, contact gathering, the state hash) walk the occupancy bits in slot order.
+
+// Refills every free stack and live list from the active flags, lowest index on top and first.
+// Generations are kept, so handles taken before the rebuild stay valid. The world's
+// asteroid, resource and unit counts are reset to the rebuilt live counts.
+void Slots_Rebuild(AppState *s);
+
+// Alloc marks the slot active and bumps the pool's live count; -1 when the pool is full
+int Slots_AllocAsteroid(AppState *s);
+void Slots_FreeAsteroid(AppState *s, int idx);
+int Slots_AllocResource(AppState *s);
+void Slots_FreeResource(AppState *s, int idx);
+int Slots_AllocUnit(AppState *s);
+void Slots_FreeUnit(AppState *s, int idx);
+int Slots_AllocParticle(AppState *s);
+void Slots_FreeParticle(AppState *s, int idx);
+
+// Handles pack a slot with its generation, so a reference kept across ticks goes stale once the
+// entity is freed instead of following whatever reuses the slot. -1 is the null handle both ways.
+int Slots_AsteroidHandle(const AppState *s, int idx);
+int Slots_ResourceHandle(const AppState *s, int idx);
+// Slot of a still-live handle, or -1
+int Slots_Asteroid(const AppState *s, int handle);
+int Slots_Resource(const AppState *s, int handle);
+
+// Checks each free stack and live list against its pool's active flags and live count, logging
+// every mismatch. Game_Update runs it once per tick in SLOTS_VALIDATE builds.
+bool Slots_Validate(const AppState *s);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SPATIAL_H
+#define SPATIAL_H
+
+#include "structs.h"
+
+#define SPATIAL_MASK(kind) (1u << (kind))
+#define SPATIAL_MASK_ALL (SPATIAL_MASK(SPATIAL_ASTEROID) | SPATIAL_MASK(SPATIAL_RESOURCE) | SPATIAL_MASK(SPATIAL_UNIT))
+
+// Flat ids pack the entity kind into one index space
+static inline int Spatial_Id(SpatialKind kind, int idx) {
+  return idx + (kind == SPATIAL_ASTEROID ? 0 : kind == SPATIAL_RESOURCE ? MAX_ASTEROIDS : MAX_ASTEROIDS + MAX_RESOURCES);
+}
+static inline SpatialKind Spatial_Kind(int id) {
+  return id < MAX_ASTEROIDS ? SPATIAL_ASTEROID : id < MAX_ASTEROIDS + MAX_RESOURCES ? SPATIAL_RESOURCE : SPATIAL_UNIT;
+}
+static inline int Spatial_Index(int id) {
+  return id < MAX_ASTEROIDS ? id : id < MAX_ASTEROIDS + MAX_RESOURCES ? id - MAX_ASTEROIDS : id - MAX_ASTEROIDS - MAX_RESOURCES;
+}
+
+// Hitbox bounds test shared by both broadphases so they agree pair for pair
+static inline bool Spatial_BoundsOverlap(Vec2 a, float ra, Vec2 b, float rb) {
+  return a.x - ra <= b.x + rb && b.x - rb <= a.x + ra && a.y - ra <= b.y + rb && b.y - rb <= a.y + ra;
+}
+
+// Asteroids in the asteroid-asteroid contact pass this tick
+static inline bool Spatial_AsteroidCollides(const AsteroidPool *a, int i) {
+  return Bits_Test(a->active, i) && a->tier[i] == SIM_TIER_FULL;
+}
+
+// Rebuilds the grid from the active pools using collision radii.
+// Game_Update keeps s->world.grid current once per tick; other threads build their own.
+void Spatial_Build(const AppState *s, SpatialGrid *g);
+
+// All queries return ids sorted ascending, so iterating them matches a linear scan of the pools.
+// Results are truncated at max_out; a buffer of SPATIAL_MAX_IDS never truncates.
+
+// Ids whose grid cells overlap the box. Candidates only, callers run their own narrow test.
+int Spatial_QueryAABB(const AppState *s, const SpatialGrid *g, float min_x, float min_y, float max_x, float max_y, Uint32 kind_mask, int *out_ids, int max_out);
+
+// Active ids whose centre lies within radius of the point. Callers testing against
+// centre distance plus the entity's size pad radius with g->max_radius.
+int Spatial_QueryRadius(const AppState *s, const SpatialGrid *g, Vec2 center, float radius, Uint32 kind_mask, int *out_ids, int max_out);
+
+// Active id with the closest centre strictly within max_dist, lowest id on ties, or -1
+int Spatial_QueryNearest(const AppState *s, const SpatialGrid *g, Vec2 center, float max_dist, Uint32 kind_mask);
+
+// First active id whose collision circle the ray enters within max_dist, or -1.
+// dir must be normalized; *out_t receives the entry distance.
+int Spatial_Raycast(const AppState *s, const SpatialGrid *g, Vec2 origin, Vec2 dir, float max_dist, Uint32 kind_mask, float *out_t);
+
+// Rebuilds sw->pairs with every colliding asteroid pair whose hitbox bounds overlap.
+// Returns the pair count, or -1 when it would exceed SWEEP_MAX_PAIRS.
+int Spatial_SweepPairs(const AppState *s, SweepState *sw);
+
+const char *Spatial_BroadphaseName(BroadphaseMode mode);
+// Returns false for an unknown name
+bool Spatial_ParseBroadphase(const char *name, BroadphaseMode *out);
+
+#endif
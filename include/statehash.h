@@ -0,0 +1,9 @@
+#ifndef STATEHASH_H
+#define STATEHASH_H
+
+#include "structs.h"
+
+// Hash of the gameplay-relevant pool state (active slots only); particles and camera are excluded
+Uint64 StateHash_World(const AppState *s);
+
+#endif
@@ -3,7 +3,9 @@
 
 #include <SDL3/SDL.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include "constants.h"
+#include "bits.h"
 
 typedef struct {
     float x, y;
@@ -84,41 +86,52 @@ typedef enum {
 
 typedef struct {
     Vec2 pos;
-    int target_idx;
+    int target; // Slots handle: asteroid to attack, crystal to gather, or -1
     CommandType type;
 } Command;
 
 typedef struct {
     Vec2 pos[MAX_UNITS];
+    Vec2 prev_pos[MAX_UNITS]; // Start-of-tick state for render interpolation
     Vec2 velocity[MAX_UNITS];
     float rotation[MAX_UNITS];
+    float prev_rotation[MAX_UNITS];
     float health[MAX_UNITS];
     float energy[MAX_UNITS];
     float current_cargo[MAX_UNITS];
     UnitType type[MAX_UNITS];
     const UnitStats *stats[MAX_UNITS];
-    bool active[MAX_UNITS];
-    float large_cannon_cooldown[MAX_UNITS];
-    float small_cannon_cooldown[MAX_UNITS][4];
+    Uint64 active[BITS_WORDS(MAX_UNITS)]; // Occupancy bitset, see bits.h
     float mining_cooldown[MAX_UNITS];
     float repair_vfx_timer[MAX_UNITS];
-    int large_target_idx[MAX_UNITS];
-    int small_target_idx[MAX_UNITS][4];
-    Command command_queue[MAX_UNITS][MAX_COMMANDS];
-    int command_count[MAX_UNITS];
-    int command_current_idx[MAX_UNITS];
-    bool has_target[MAX_UNITS];
-    Vec2 patrol_start[MAX_UNITS];
-    bool patrolling_back[MAX_UNITS];
-    TacticalBehavior behavior[MAX_UNITS];
-    
-    // Production
-    UnitType production_mode[MAX_UNITS]; // UNIT_TYPE_COUNT means "Off"
-    UnitType production_queue[MAX_UNITS][MAX_PRODUCTION_QUEUE];
-    int production_count[MAX_UNITS];
-    float production_timer[MAX_UNITS];
 } UnitPool;
 
+// Command state per unit slot. Kept out of UnitPool so integration, collision and rendering
+// don't stream the queues through the cache; index it with the slot a unit handle resolves to.
+typedef struct {
+    Command queue[MAX_UNITS][MAX_COMMANDS];
+    int count[MAX_UNITS];
+    int current_idx[MAX_UNITS];
+    bool has_target[MAX_UNITS]; // queue[current_idx] is being carried out
+    TacticalBehavior behavior[MAX_UNITS];
+} UnitOrderPool;
+
+// Weapon state per unit slot, targets as asteroid handles, kept out of UnitPool since only armed units read it
+typedef struct {
+    int large[MAX_UNITS];
+    int small[MAX_UNITS][4]; // Written by the targeting thread under unit_fx_mutex
+    float large_cooldown[MAX_UNITS];
+    float small_cooldown[MAX_UNITS][4];
+} UnitTargetPool;
+
+// Production state per unit slot; only motherships ever use it
+typedef struct {
+    UnitType mode[MAX_UNITS]; // UNIT_TYPE_COUNT means "Off"
+    UnitType queue[MAX_UNITS][MAX_PRODUCTION_QUEUE];
+    int count[MAX_UNITS];
+    float timer[MAX_UNITS];
+} ProductionPool;
+
 typedef struct {
     int selected_res_index; // 0: 1280x720, 1: 1920x1080
     bool fullscreen;
@@ -141,32 +154,52 @@ typedef enum {
     EXPLOSION_COLLISION
 } ExplosionType;
 
+// Motion is stored as separate x/y lanes, each starting on a cache line, so Particles_Update
+// integrates several slots per SIMD op. particles.h has Vec2 accessors for everything else.
 typedef struct {
-    Vec2 pos[MAX_PARTICLES];
-    Vec2 velocity[MAX_PARTICLES];
+    _Alignas(64) float pos_x[MAX_PARTICLES];
+    _Alignas(64) float pos_y[MAX_PARTICLES];
+    _Alignas(64) float prev_x[MAX_PARTICLES]; // Start-of-tick position for render interpolation
+    _Alignas(64) float prev_y[MAX_PARTICLES];
+    _Alignas(64) float vel_x[MAX_PARTICLES];
+    _Alignas(64) float vel_y[MAX_PARTICLES];
     float life[MAX_PARTICLES];
     float size[MAX_PARTICLES];
     float rotation[MAX_PARTICLES];
-    int tex_idx[MAX_PARTICLES];
-    int asteroid_tex_idx[MAX_PARTICLES];
+    Uint8 tex_idx[MAX_PARTICLES];
+    Uint8 asteroid_tex_idx[MAX_PARTICLES];
     SDL_Color color[MAX_PARTICLES];
-    ParticleType type[MAX_PARTICLES];
-    bool active[MAX_PARTICLES];
-    Vec2 target_pos[MAX_PARTICLES];
-    int unit_idx[MAX_PARTICLES];
+    Uint8 type[MAX_PARTICLES]; // ParticleType
+    Uint64 active[BITS_WORDS(MAX_PARTICLES)]; // Occupancy bitset, see bits.h
 } ParticlePool;
 
+// Tracer endpoints, only meaningful for PARTICLE_TRACER slots
+typedef struct {
+    Vec2 target_pos[MAX_PARTICLES];
+    Sint16 unit_idx[MAX_PARTICLES];
+} TracerPool;
+
+typedef enum {
+    SIM_TIER_FULL,  // Integrated every tick and collided
+    SIM_TIER_DRIFT, // Coarse integration, no asteroid-asteroid contacts
+    SIM_TIER_SLEEP  // Not integrated; banks its time in drift_dt
+} SimTier;
+
 typedef struct {
     Vec2 pos[MAX_ASTEROIDS];
+    Vec2 prev_pos[MAX_ASTEROIDS];
     Vec2 velocity[MAX_ASTEROIDS];
     float radius[MAX_ASTEROIDS];
     float rotation[MAX_ASTEROIDS];
+    float prev_rotation[MAX_ASTEROIDS];
     float rot_speed[MAX_ASTEROIDS];
     float health[MAX_ASTEROIDS];
     float max_health[MAX_ASTEROIDS];
-    int tex_idx[MAX_ASTEROIDS];
-    bool active[MAX_ASTEROIDS];
-    bool targeted[MAX_ASTEROIDS];
+    float drift_dt[MAX_ASTEROIDS]; // Banked time not yet integrated
+    Uint8 tex_idx[MAX_ASTEROIDS];
+    Uint8 tier[MAX_ASTEROIDS]; // SimTier, set by the despawn check each tick
+    Uint64 active[BITS_WORDS(MAX_ASTEROIDS)]; // Occupancy bitset, see bits.h
+    Uint64 targeted[BITS_WORDS(MAX_ASTEROIDS)];
 } AsteroidPool;
 
 typedef struct {
@@ -177,29 +210,32 @@ typedef struct {
 
 typedef struct {
     Vec2 pos;
+    Vec2 prev_pos;
     float zoom;
     float shake_intensity;
+    int view_w, view_h; // Output size in pixels, fed by the frontend each frame
 } CameraState;
 
 typedef struct {
     int primary_unit_idx;
-    bool unit_selected[MAX_UNITS];
+    Uint64 unit_selected[BITS_WORDS(MAX_UNITS)];
     bool box_active;
     Vec2 box_start;
     Vec2 box_current;
 
     // Control Groups
-    bool group_members[10][MAX_UNITS]; // 1-9 are groups.
+    Uint64 group_members[10][BITS_WORDS(MAX_UNITS)]; // 1-9 are groups.
 } SelectionState;
 
 typedef struct {
     CommandType pending_cmd_type;
     AbilityInputType pending_input_type;
     Vec2 mouse_pos;
-    int hover_asteroid_idx;
-    int hover_resource_idx;
+    int hover_asteroid; // Handles, so the renderer never follows a slot freed since the pick
+    int hover_resource;
     bool show_grid;
     bool show_density;
+    bool show_profiler;
     bool shift_down;
     bool ctrl_down;
     bool key_q_down, key_w_down, key_e_down, key_r_down, key_a_down, key_s_down, key_d_down, key_y_down, key_x_down, key_c_down;
@@ -207,24 +243,187 @@ typedef struct {
 
 typedef struct {
     Vec2 pos[MAX_RESOURCES];
+    Vec2 prev_pos[MAX_RESOURCES];
     Vec2 velocity[MAX_RESOURCES];
     float radius[MAX_RESOURCES];
     float rotation[MAX_RESOURCES];
+    float prev_rotation[MAX_RESOURCES];
     float rot_speed[MAX_RESOURCES];
     float amount[MAX_RESOURCES];
     float health[MAX_RESOURCES];
     float max_health[MAX_RESOURCES];
-    int tex_idx[MAX_RESOURCES];
-    bool active[MAX_RESOURCES];
+    Uint8 tex_idx[MAX_RESOURCES];
+    Uint64 active[BITS_WORDS(MAX_RESOURCES)]; // Occupancy bitset, see bits.h
 } ResourcePool;
 
+typedef struct {
+    Uint64 state;
+    Uint64 inc;
+} Rng;
+
+typedef enum {
+    SPATIAL_ASTEROID,
+    SPATIAL_RESOURCE,
+    SPATIAL_UNIT,
+    SPATIAL_KIND_COUNT
+} SpatialKind;
+
+typedef struct {
+    Sint32 cx, cy;
+    int id; // Flat id, see Spatial_Id
+    Sint16 ox, oy; // Offset from the entity's first cell, used to report it once per query
+} SpatialEntry;
+
+typedef struct {
+    Sint32 x0, y0, x1, y1;
+    int id;
+} SpatialSpan;
+
+// Hashed uniform grid over asteroids, resources and units, rebuilt once per tick.
+// Queries only read it, so any thread holding a grid may query it.
+typedef struct {
+    int bucket_start[SPATIAL_BUCKETS + 1];
+    SpatialEntry entries[SPATIAL_MAX_ENTRIES];
+    SpatialSpan spans[SPATIAL_MAX_IDS]; // Cell range per entity, captured once so a build sees consistent positions
+    int entry_count, span_count;
+    Sint32 min_cx, min_cy, max_cx, max_cy; // Occupied cell bounds
+    float max_radius[SPATIAL_KIND_COUNT]; // Largest pool radius per kind, for callers padding their own predicates
+    bool valid; // False when the last build overflowed; queries then scan the pools linearly
+} SpatialGrid;
+
+typedef enum {
+    BROADPHASE_GRID,
+    BROADPHASE_SAP,
+    BROADPHASE_COUNT
+} BroadphaseMode;
+
+// Sort-and-sweep over asteroid x-extents. The order persists between ticks so the
+// insertion sort only fixes up the few asteroids that overtook a neighbour.
+typedef struct {
+    Sint16 order[MAX_ASTEROIDS]; // Every slot, sorted by min_x with inactive slots last
+    float min_x[MAX_ASTEROIDS];
+    Uint32 pairs[SWEEP_MAX_PAIRS]; // (i << 16) | j with i < j, sorted ascending
+    int pair_count;
+    int shifts; // Insertion sort moves in the last sweep, a measure of coherence
+    bool seeded;
+} SweepState;
+
+// Asteroid contacts for one collision pass. Pairs are grouped into batches in which no
+// asteroid appears twice, so a batch can be solved on several threads at once.
+typedef struct {
+    Uint32 gathered[CONTACT_MAX_PAIRS]; // Per-asteroid runs in whatever order the gather jobs finished
+    int run_start[MAX_ASTEROIDS], run_count[MAX_ASTEROIDS];
+    SDL_AtomicInt gathered_count;
+    Uint32 ordered[CONTACT_MAX_PAIRS]; // (i << 16) | j with i < j, ascending
+    Uint32 batched[CONTACT_MAX_PAIRS]; // Same pairs grouped by batch, ascending within a batch
+    Uint16 pair_batch[CONTACT_MAX_PAIRS]; // 1-based batch per ordered pair
+    int batch_start[CONTACT_MAX_PAIRS + 1];
+    int batch_count;
+    int pair_count;
+    Uint16 last_batch[MAX_ASTEROIDS]; // 1-based batch of the asteroid's latest pair, 0 for none
+    Uint8 touching[CONTACT_MAX_PAIRS]; // Per batched pair
+    float impulse[CONTACT_MAX_PAIRS]; // Per batched pair, 0 unless the pair was pushed apart
+    bool split[MAX_ASTEROIDS]; // Hit hard enough to split once the pass is over
+    bool swept[MAX_ASTEROIDS]; // Already resolved by the swept test this tick
+} ContactState;
+
+typedef enum {
+    COLLISION_ASTEROID_ASTEROID,
+    COLLISION_UNIT_ASTEROID,
+    COLLISION_UNIT_RESOURCE,
+    // Outcomes, emitted when the command flush applies them
+    COLLISION_ASTEROID_SPLIT,
+    COLLISION_ASTEROID_DESTROYED
+} CollisionEventType;
+
+typedef struct {
+    Vec2 point;
+    float magnitude; // Contact impulse, or the asteroid's radius for outcomes
+    Sint16 a, b; // Unit first for unit contacts; b is -1 for outcomes
+    Uint8 type; // CollisionEventType
+    Uint8 tex_idx; // Outcomes only
+} CollisionEvent;
+
+// Everything the collision pass produced this tick. Damage, splitting and VFX each consume it in their own pass.
+typedef struct {
+    CollisionEvent events[COLLISION_EVENT_CAP];
+    int count;
+    int dropped; // Past the cap this tick; contacts among them still deal damage
+    bool skip_vfx; // Headless runs can leave the VFX consumer out
+} CollisionEvents;
+
+typedef enum {
+    COMMAND_SPLIT_ASTEROID,
+    COMMAND_DESTROY_ASTEROID, // Explodes, with blast damage if blast is set
+    COMMAND_SPAWN_ASTEROID,
+    COMMAND_SPAWN_CRYSTAL
+} WorldCommandType;
+
+typedef struct {
+    WorldCommandType type;
+    int idx; // Target asteroid
+    bool blast;
+    Vec2 pos, vel; // vel is the spawn direction
+    float radius;
+} WorldCommand;
+
+// Area damage inside range, scaled per body kind. Falloff blasts fade linearly to the edge
+// of range; flat ones deal full damage throughout.
+typedef struct {
+    Vec2 pos;
+    float range, damage;
+    float unit_mult, asteroid_mult;
+    bool falloff;
+    bool shake; // Feeds the batch's camera shake
+    int exclude_unit_idx; // -1 for none
+    int exclude_asteroid_idx; // -1 for none
+} AreaBlast;
+
+// Structural changes queued during a pass and applied together once it is over
+typedef struct {
+    WorldCommand cmds[COMMAND_QUEUE_SIZE];
+    int count;
+    AreaBlast blasts[COMMAND_QUEUE_SIZE]; // Resolved as one batch per flush
+    int blast_count;
+    Uint64 destroy_pending[BITS_WORDS(MAX_ASTEROIDS)]; // Asteroids with a destroy queued this flush
+} CommandQueue;
+
+// Slot bookkeeping for one pool: inactive slots as a stack whose top is handed out next,
+// live slots as a dense swap-removed list, and a generation per slot for handles
+#define SLOT_LIST(capacity) struct { \
+    Uint16 free[capacity]; \
+    Uint16 live[capacity]; \
+    Uint16 live_pos[capacity]; /* Position of a live slot in live[] */ \
+    Uint16 generation[capacity]; /* Bumped each time the slot is freed */ \
+    int free_count; \
+    int live_count; \
+}
+
+typedef struct {
+    SLOT_LIST(MAX_ASTEROIDS) asteroids;
+    SLOT_LIST(MAX_RESOURCES) resources;
+    SLOT_LIST(MAX_UNITS) units;
+    SLOT_LIST(MAX_PARTICLES) particles;
+} SlotLists;
+
+// Per-target damage sums for one blast batch, indexed by flat spatial id
+typedef struct {
+    float sum[SPATIAL_MAX_IDS];
+    bool hit[SPATIAL_MAX_IDS]; // Cleared again as the sums are applied
+    int touched[SPATIAL_MAX_IDS]; // First-hit order
+} BlastState;
+
 typedef struct {
     AsteroidPool asteroids;
     int asteroid_count;
     UnitPool units;
+    UnitOrderPool orders;
+    UnitTargetPool targets;
+    ProductionPool production;
     UnitStats unit_stats[UNIT_TYPE_COUNT];
     int unit_count;
     ParticlePool particles;
+    TracerPool tracers;
     int particle_next_idx;
     ResourcePool resources;
     int resource_count;
@@ -232,6 +431,18 @@ typedef struct {
     int sim_anchor_count;
     float energy;
     float stored_resources;
+    Uint64 seed;
+    Rng rng_sim; // Gameplay: spawning, splitting, drops, production, camera shake
+    Rng rng_vfx; // Cosmetic particles only, never read by the simulation
+    Uint64 state_hash; // StateHash_World at the end of the last tick
+    SpatialGrid grid;
+    SweepState sweep;
+    ContactState contacts;
+    CollisionEvents collision_events;
+    CommandQueue commands;
+    SlotLists slots;
+    BlastState blast;
+    BroadphaseMode broadphase; // Asteroid-asteroid pair finder, picked at startup
 } WorldState;
 
 typedef struct {
@@ -289,6 +500,8 @@ typedef struct {
     SDL_Thread *unit_fx_thread;
     SDL_Mutex *unit_fx_mutex;
     SDL_AtomicInt unit_fx_should_quit;
+    SDL_AtomicInt targeting_pass_us; // Duration of the last targeting thread pass
+    SpatialGrid targeting_grid; // Private to the targeting pass, which runs off the sim tick
     Uint32 *mothership_hull_buffer;
     Uint32 *mothership_arm_buffer;
     SDL_AtomicInt mothership_data_ready;
@@ -315,6 +528,112 @@ typedef struct {
     float resource_log_timer;
 } UIState;
 
+// Parents are defined by the zone table in profiler.c
+typedef enum {
+    PROF_FRAME,
+    PROF_TARGETING, // Inline targeting (headless only, the game runs it on a thread)
+    PROF_UPDATE,
+    PROF_UPDATE_MISC,
+    PROF_PRODUCTION,
+    PROF_HOVER,
+    PROF_SPAWNING,
+    PROF_INTEGRATE,
+    PROF_COLLISIONS,
+    PROF_UNITS,
+    PROF_UNIT_MOVEMENT,
+    PROF_ABILITIES,
+    PROF_PARTICLES,
+    PROF_RENDER,
+    PROF_RENDER_BACKGROUND,
+    PROF_RENDER_PARALLAX,
+    PROF_RENDER_ASTEROIDS,
+    PROF_RENDER_CRYSTALS,
+    PROF_RENDER_UNITS,
+    PROF_RENDER_PARTICLES,
+    PROF_RENDER_HUD,
+    PROF_RENDER_PRESENT,
+    PROF_ZONE_COUNT
+} ProfileZone;
+
+typedef struct {
+    Uint64 zone_start[PROF_ZONE_COUNT];
+    Uint64 zone_ticks[PROF_ZONE_COUNT]; // Accumulated counter ticks for the current frame
+    float history_ms[PROFILER_HISTORY_FRAMES][PROF_ZONE_COUNT];
+    int history_head;
+    int history_count;
+} ProfilerState;
+
+typedef enum {
+    TRACE_THREAD_MAIN,
+    TRACE_THREAD_BACKGROUND,
+    TRACE_THREAD_DENSITY,
+    TRACE_THREAD_TARGETING,
+    TRACE_THREAD_COUNT
+} TraceThread;
+
+typedef struct {
+    const char *name; // Must point at static storage
+    Uint64 ts;
+    char phase; // 'B', 'E' or 'i' as in the Chrome trace format
+} TraceEvent;
+
+// Single producer (the owning thread), single consumer (the dump)
+typedef struct {
+    TraceEvent events[TRACE_RING_CAPACITY];
+    SDL_AtomicInt head; // Total events written, wraps through the ring
+} TraceRing;
+
+typedef struct {
+    Uint64 base_counter;
+    TraceRing rings[TRACE_THREAD_COUNT];
+} TraceState;
+
+// Rolling log-linear histogram of durations in microseconds
+typedef struct {
+    int counts[HISTOGRAM_BUCKETS];
+    Uint16 samples[HISTOGRAM_WINDOW]; // Bucket of each sample in the window, oldest is evicted
+    int head;
+    int count;
+} Histogram;
+
+typedef struct {
+    Histogram frame_hist;
+    Histogram tick_hist;
+    int stutter_count;
+} FrameStatsState;
+
+// Algorithmic work done by each system, reset every tick (draw_calls every frame)
+typedef struct {
+    int collision_pairs_tested;
+    int collision_pairs_resolved;
+    int spawn_attempts;
+    int spawn_rejections;
+    int particles_allocated;
+    int particles_overwritten; // Ring slot was still alive
+    SDL_AtomicInt targeting_candidates; // Asteroids scored in the last targeting pass
+    int commands_applied;
+    int commands_dropped; // Queue was full
+    int draw_calls;
+    int tick;
+    FILE *csv;
+} WorkCounters;
+
+typedef void (*JobFn)(void *ctx, int begin, int end);
+
+// Fixed pool of sim workers. Only the sim thread dispatches, and it works on the job too.
+typedef struct {
+    SDL_Thread *threads[JOBS_MAX_WORKERS];
+    int worker_count;
+    SDL_Semaphore *start; // One signal per woken worker per dispatch
+    SDL_Semaphore *done;
+    SDL_AtomicInt quit;
+    // Current dispatch
+    JobFn fn;
+    void *ctx;
+    int count, grain;
+    SDL_AtomicInt next; // First unclaimed index
+} JobPool;
+
 typedef struct {
     GameState game_state;
     LauncherState launcher;
@@ -325,11 +644,21 @@ typedef struct {
     TextureState textures;
     ThreadState threads;
     UIState ui;
+    ProfilerState profiler;
+    TraceState trace;
+    FrameStatsState frame_stats;
+    WorkCounters counters;
+    JobPool jobs;
 
     int assets_generated;
     float current_fps;
     float current_time;
 
+    // Fixed-step simulation
+    float sim_dt;
+    float sim_accumulator;
+    float render_alpha; // Blend factor between prev_* and current state
+
     SDL_Renderer *renderer;
     SDL_Window *window;
 } AppState;
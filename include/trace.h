@@ -0,0 +1,12 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "structs.h"
+
+void Trace_Init(AppState *s);
+void Trace_Begin(AppState *s, TraceThread thread, const char *name);
+void Trace_End(AppState *s, TraceThread thread, const char *name);
+void Trace_Instant(AppState *s, TraceThread thread, const char *name);
+bool Trace_WriteChromeJson(AppState *s, const char *filename);
+
+#endif
@@ -1,16 +1,19 @@
 #include "abilities.h"
 #include "constants.h"
 #include "weapons.h"
+#include "particles.h"
 #include "utils.h"
+#include "rng.h"
+#include "slots.h"
 #include <math.h>
 #include <stdlib.h>
 
 static void UpdateCooldowns(AppState *s, int idx, float dt) {
-    if (s->world.units.large_cannon_cooldown[idx] > 0)
-        s->world.units.large_cannon_cooldown[idx] -= dt;
+    if (s->world.targets.large_cooldown[idx] > 0)
+        s->world.targets.large_cooldown[idx] -= dt;
     for (int c = 0; c < 4; c++)
-        if (s->world.units.small_cannon_cooldown[idx][c] > 0)
-            s->world.units.small_cannon_cooldown[idx][c] -= dt;
+        if (s->world.targets.small_cooldown[idx][c] > 0)
+            s->world.targets.small_cooldown[idx][c] -= dt;
     if (s->world.units.mining_cooldown[idx] > 0)
         s->world.units.mining_cooldown[idx] -= dt;
     if (s->world.units.repair_vfx_timer[idx] > 0)
@@ -19,28 +22,29 @@ static void UpdateCooldowns(AppState *s, int idx, float dt) {
 
 static void HandleManualMainCannon(AppState *s, int idx) {
     SDL_LockMutex(s->threads.unit_fx_mutex);
-    int l_target = s->world.units.large_target_idx[idx];
+    int l_handle = s->world.targets.large[idx];
     SDL_UnlockMutex(s->threads.unit_fx_mutex);
 
-    if (l_target == -1) return;
+    if (l_handle == -1) return;
 
-    if (!s->world.asteroids.active[l_target]) {
-        s->world.units.large_target_idx[idx] = -1;
+    int l_target = Slots_Asteroid(s, l_handle);
+    if (l_target == -1) {
+        s->world.targets.large[idx] = -1;
         return;
     }
 
-    s->world.asteroids.targeted[l_target] = true;
+    Bits_Set(s->world.asteroids.targeted, l_target);
     float dsq = Vector_DistanceSq(s->world.asteroids.pos[l_target], s->world.units.pos[idx]);
     float max_d = s->world.units.stats[idx]->main_cannon_range + s->world.asteroids.radius[l_target] * ASTEROID_HITBOX_MULT;
 
     if (dsq <= max_d * max_d) {
-        if (s->world.units.large_cannon_cooldown[idx] <= 0) {
+        if (s->world.targets.large_cooldown[idx] <= 0) {
             Weapons_Fire(s, idx, l_target, s->world.units.stats[idx]->main_cannon_damage, 0.0f, true);
-            s->world.units.large_cannon_cooldown[idx] = s->world.units.stats[idx]->main_cannon_cooldown;
-            s->world.units.large_target_idx[idx] = -1;
+            s->world.targets.large_cooldown[idx] = s->world.units.stats[idx]->main_cannon_cooldown;
+            s->world.targets.large[idx] = -1;
         }
     } else {
-        s->world.units.large_target_idx[idx] = -1;
+        s->world.targets.large[idx] = -1;
     }
 }
 
@@ -49,60 +53,58 @@ static void HandleAutoAttacks(AppState *s, int idx) {
     bool is_aggressive_cmd = false;
     bool is_gathering = false;
     
-    if (s->world.units.has_target[idx]) {
-        Command *cmd = &s->world.units.command_queue[idx][s->world.units.command_current_idx[idx]];
+    if (s->world.orders.has_target[idx]) {
+        Command *cmd = &s->world.orders.queue[idx][s->world.orders.current_idx[idx]];
         if (cmd->type == CMD_MOVE) is_moving_normally = true;
         if (cmd->type == CMD_ATTACK_MOVE || cmd->type == CMD_PATROL) is_aggressive_cmd = true;
         if (cmd->type == CMD_GATHER || cmd->type == CMD_RETURN_CARGO) is_gathering = true;
     }
 
-    if (s->world.units.behavior[idx] == BEHAVIOR_PASSIVE) return;
+    if (s->world.orders.behavior[idx] == BEHAVIOR_PASSIVE) return;
     
     // Aggressive units (Offensive/Defensive) can fire while moving (e.g. following mothership).
     // Only return if it's a pure Move command AND behavior is NOT aggressive.
-    if (is_moving_normally && s->world.units.behavior[idx] == BEHAVIOR_HOLD_GROUND) return;
+    if (is_moving_normally && s->world.orders.behavior[idx] == BEHAVIOR_HOLD_GROUND) return;
 
     SDL_LockMutex(s->threads.unit_fx_mutex);
     int s_targets[4];
-    for (int c = 0; c < 4; c++) s_targets[c] = s->world.units.small_target_idx[idx][c];
+    for (int c = 0; c < 4; c++) s_targets[c] = s->world.targets.small[idx][c];
     SDL_UnlockMutex(s->threads.unit_fx_mutex);
 
     for (int c = 0; c < 4; c++) {
-        int t_idx = s_targets[c];
+        int t_idx = Slots_Asteroid(s, s_targets[c]);
         if (t_idx == -1) continue;
 
-        if (!s->world.asteroids.active[t_idx]) continue;
-
-        s->world.asteroids.targeted[t_idx] = true;
+        Bits_Set(s->world.asteroids.targeted, t_idx);
         
         float range_mult = 1.0f;
         bool is_command_target = false;
-        if (s->world.units.has_target[idx]) {
-            Command *cmd = &s->world.units.command_queue[idx][s->world.units.command_current_idx[idx]];
-            if (cmd->type == CMD_ATTACK_MOVE && cmd->target_idx == t_idx) is_command_target = true;
+        if (s->world.orders.has_target[idx]) {
+            Command *cmd = &s->world.orders.queue[idx][s->world.orders.current_idx[idx]];
+            if (cmd->type == CMD_ATTACK_MOVE && cmd->target == s_targets[c]) is_command_target = true;
         }
 
         if (!is_command_target && !is_aggressive_cmd) {
-            if (s->world.units.behavior[idx] == BEHAVIOR_HOLD_GROUND) {
+            if (s->world.orders.behavior[idx] == BEHAVIOR_HOLD_GROUND) {
                 if (s->world.units.type[idx] == UNIT_MINER) continue; // Miners focus on mining
                 range_mult = 1.0f; // Others act as turrets
             }
             // Defensive units now use full range if aggressive commands aren't active
-            else if (s->world.units.behavior[idx] == BEHAVIOR_DEFENSIVE) range_mult = 1.0f; 
+            else if (s->world.orders.behavior[idx] == BEHAVIOR_DEFENSIVE) range_mult = 1.0f; 
         }
 
         float dsq = Vector_DistanceSq(s->world.asteroids.pos[t_idx], s->world.units.pos[idx]);
         float max_d = (s->world.units.stats[idx]->small_cannon_range * range_mult) + s->world.asteroids.radius[t_idx] * ASTEROID_HITBOX_MULT;
 
-        if (dsq <= max_d * max_d && s->world.units.small_cannon_cooldown[idx][c] <= 0) {
+        if (dsq <= max_d * max_d && s->world.targets.small_cooldown[idx][c] <= 0) {
             Weapons_Fire(s, idx, t_idx, s->world.units.stats[idx]->small_cannon_damage, s->world.units.stats[idx]->small_cannon_energy_cost, false);
-            s->world.units.small_cannon_cooldown[idx][c] = s->world.units.stats[idx]->small_cannon_cooldown;
+            s->world.targets.small_cooldown[idx][c] = s->world.units.stats[idx]->small_cannon_cooldown;
         }
     }
 }
 
 void Abilities_Mine(AppState *s, int idx, int resource_idx, float dt) {
-    if (!s->world.resources.active[resource_idx]) return;
+    if (!Bits_Test(s->world.resources.active, resource_idx)) return;
 
     if (s->world.units.type[idx] == UNIT_MOTHERSHIP || s->world.units.current_cargo[idx] < s->world.units.stats[idx]->max_cargo) {
         float mining_rate = 100.0f; 
@@ -139,7 +141,7 @@ void Abilities_Mine(AppState *s, int idx, int resource_idx, float dt) {
 }
 
 void Abilities_Repair(AppState *s, int idx, int target_idx, float dt) {
-    if (!s->world.units.active[target_idx]) return;
+    if (!Bits_Test(s->world.units.active, target_idx)) return;
     
     float repair_rate = 50.0f; // 50 HP per second
     float amount = repair_rate * dt;
@@ -155,29 +157,25 @@ void Abilities_Repair(AppState *s, int idx, int target_idx, float dt) {
         float dy = s->world.units.pos[target_idx].y - s->world.units.pos[idx].y;
         float dist = sqrtf(dx*dx + dy*dy);
         if (dist > 0.1f) {
-            int p_idx = s->world.particle_next_idx;
-            s->world.particles.active[p_idx] = true;
+            int p_idx = Particles_Alloc(s);
             s->world.particles.type[p_idx] = PARTICLE_TRACER;
-            s->world.particles.pos[p_idx] = s->world.units.pos[idx];
-            s->world.particles.target_pos[p_idx] = s->world.units.pos[target_idx];
-            s->world.particles.unit_idx[p_idx] = idx;
+            Particles_SetPos(s, p_idx, s->world.units.pos[idx]);
+            s->world.tracers.target_pos[p_idx] = s->world.units.pos[target_idx];
+            s->world.tracers.unit_idx[p_idx] = idx;
             s->world.particles.life[p_idx] = 0.3f;
             s->world.particles.size[p_idx] = 4.0f;
             s->world.particles.color[p_idx] = (SDL_Color){100, 255, 100, 255}; // Green
-            s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
         }
 
         // Periodic Healing Wave VFX
         if (s->world.units.repair_vfx_timer[idx] <= 0) {
-            int sw_idx = s->world.particle_next_idx;
-            s->world.particles.active[sw_idx] = true;
+            int sw_idx = Particles_Alloc(s);
             s->world.particles.type[sw_idx] = PARTICLE_SHOCKWAVE;
-            s->world.particles.pos[sw_idx] = s->world.units.pos[idx];
-            s->world.particles.velocity[sw_idx] = (Vec2){0,0};
+            Particles_SetPos(s, sw_idx, s->world.units.pos[idx]);
+            Particles_SetVelocity(s, sw_idx, (Vec2){0,0});
             s->world.particles.life[sw_idx] = 1.2f; // Longer life for slower wave
             s->world.particles.size[sw_idx] = 100.0f; // Start small
             s->world.particles.color[sw_idx] = (SDL_Color){0, 255, 0, 40}; // Reduced from 80
-            s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
             
             s->world.units.repair_vfx_timer[idx] = 1.5f; // More delayed
         }
@@ -199,8 +197,7 @@ void Abilities_Update(AppState *s, int idx, float dt) {
         int best_repair_target = -1;
         float lowest_hp_pct = 1.0f;
 
-        for (int u = 0; u < MAX_UNITS; u++) {
-            if (!s->world.units.active[u]) continue;
+        BITS_FOR_EACH(u, s->world.units.active, MAX_UNITS) {
             float dsq = Vector_DistanceSq(s->world.units.pos[idx], s->world.units.pos[u]);
             if (dsq <= repair_range * repair_range) {
                 float hp_pct = s->world.units.health[u] / s->world.units.stats[u]->max_health;
@@ -222,8 +219,7 @@ void Abilities_Update(AppState *s, int idx, float dt) {
             int best_crystal = -1;
             float min_dsq = 1e15f;
 
-            for (int r = 0; r < MAX_RESOURCES; r++) {
-                if (!s->world.resources.active[r]) continue;
+            BITS_FOR_EACH(r, s->world.resources.active, MAX_RESOURCES) {
                 float dsq = Vector_DistanceSq(s->world.units.pos[idx], s->world.resources.pos[r]);
                 float crystal_rad = s->world.resources.radius[r] * CRYSTAL_VISUAL_SCALE * 0.5f;
                 float effective_range = base_mine_range + crystal_rad;
@@ -245,7 +241,7 @@ void Abilities_Update(AppState *s, int idx, float dt) {
     if (s->world.units.current_cargo[idx] > 0 && s->world.units.type[idx] != UNIT_MOTHERSHIP) {
         int mothership_idx = -1;
         for (int i = 0; i < MAX_UNITS; i++) {
-            if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) { mothership_idx = i; break; }
+            if (Bits_Test(s->world.units.active, i) && s->world.units.type[i] == UNIT_MOTHERSHIP) { mothership_idx = i; break; }
         }
         if (mothership_idx != -1) {
             float dsq = Vector_DistanceSq(s->world.units.pos[idx], s->world.units.pos[mothership_idx]);
@@ -258,24 +254,22 @@ void Abilities_Update(AppState *s, int idx, float dt) {
                 s->ui.resource_accumulator += amount;
 
                 // Visual: Flowing bits to mothership
-                if (rand() % 100 < 20) {
-                    int p_idx = s->world.particle_next_idx;
-                    s->world.particles.active[p_idx] = true;
+                if (Rng_Int(&s->world.rng_vfx, 100) < 20) {
+                    int p_idx = Particles_Alloc(s);
                     s->world.particles.type[p_idx] = PARTICLE_SPARK;
-                    s->world.particles.pos[p_idx] = s->world.units.pos[idx];
-                    s->world.particles.velocity[p_idx] = Vector_Scale(Vector_Normalize(Vector_Sub(s->world.units.pos[mothership_idx], s->world.units.pos[idx])), 800.0f);
+                    Particles_SetPos(s, p_idx, s->world.units.pos[idx]);
+                    Particles_SetVelocity(s, p_idx, Vector_Scale(Vector_Normalize(Vector_Sub(s->world.units.pos[mothership_idx], s->world.units.pos[idx])), 800.0f));
                     s->world.particles.life[p_idx] = 0.6f;
                     s->world.particles.size[p_idx] = 6.0f;
                     s->world.particles.color[p_idx] = (SDL_Color){150, 255, 150, 255};
-                    s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
                 }
             }
         }
     }
 
-    if (s->world.units.has_target[idx]) {
-        Command *cmd = &s->world.units.command_queue[idx][s->world.units.command_current_idx[idx]];
-        if (cmd->type == CMD_GATHER && cmd->target_idx != -1) {
+    if (s->world.orders.has_target[idx]) {
+        Command *cmd = &s->world.orders.queue[idx][s->world.orders.current_idx[idx]];
+        if (cmd->type == CMD_GATHER && cmd->target != -1) {
             if (s->world.units.current_cargo[idx] >= s->world.units.stats[idx]->max_cargo) {
                 cmd->type = CMD_RETURN_CARGO;
             } else {
@@ -284,11 +278,11 @@ void Abilities_Update(AppState *s, int idx, float dt) {
             }
         } else if (cmd->type == CMD_RETURN_CARGO) {
             if (s->world.units.current_cargo[idx] <= 0) {
-                if (cmd->target_idx != -1 && s->world.resources.active[cmd->target_idx]) {
+                if (Slots_Resource(s, cmd->target) != -1) {
                     cmd->type = CMD_GATHER;
                 } else {
                     // Resource gone, just stop
-                    s->world.units.has_target[idx] = false;
+                    s->world.orders.has_target[idx] = false;
                 }
             }
         }
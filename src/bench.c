@@ -0,0 +1,276 @@
+#include "constants.h"
+#include "game.h"
+#include "headless.h"
+#include "particles.h"
+#include "profiler.h"
+#include "rng.h"
+#include "spatial.h"
+#include "jobs.h"
+#include "utils.h"
+#include <SDL3/SDL.h>
+#include <math.h>
+#include <stdio.h>
+
+typedef void (*ScenarioSetupFn)(AppState *s);
+typedef void (*ScenarioTickFn)(AppState *s, int tick);
+
+typedef struct {
+  const char *name;
+  ScenarioSetupFn setup;
+  ScenarioTickFn tick; // Optional per-tick driver, runs before the sim step
+} Scenario;
+
+static const ProfileZone bench_zones[] = {PROF_COLLISIONS, PROF_UNIT_MOVEMENT, PROF_PARTICLES, PROF_SPAWNING};
+#define BENCH_ZONE_COUNT ((int)SDL_arraysize(bench_zones))
+#define BENCH_SPARSE_ASTEROIDS 256
+
+// Scenario setup draws from the gameplay stream so a seed reproduces the whole run
+static float RandRange(AppState *s, float lo, float hi) { return lo + Rng_Float(&s->world.rng_sim) * (hi - lo); }
+
+static Vec2 RandRing(AppState *s, float r_min, float r_max) {
+  float angle = RandRange(s, 0.0f, 2.0f * SDL_PI_F), dist = RandRange(s, r_min, r_max);
+  return (Vec2){cosf(angle) * dist, sinf(angle) * dist};
+}
+
+static void FillAsteroids(AppState *s, int count, float r_min, float r_max) {
+  for (int i = 0; i < count && s->world.asteroid_count < MAX_ASTEROIDS; i++) {
+    Vec2 pos = RandRing(s, r_min, r_max);
+    float angle = RandRange(s, 0.0f, 2.0f * SDL_PI_F);
+    SpawnAsteroid(s, pos, (Vec2){cosf(angle), sinf(angle)}, ASTEROID_MIN_RADIUS + (float)Rng_Int(&s->world.rng_sim, (int)ASTEROID_BASE_RADIUS_VARIANCE));
+  }
+}
+
+// Dense galaxy belt: every asteroid slot in use inside the despawn range
+static void SetupBelt(AppState *s) {
+  FillAsteroids(s, MAX_ASTEROIDS, SPAWN_SAFE_ZONE, DESPAWN_RANGE * 0.9f);
+}
+
+static void TickBelt(AppState *s, int tick) {
+  (void)tick;
+  FillAsteroids(s, MAX_ASTEROIDS - s->world.asteroid_count, SPAWN_SAFE_ZONE, DESPAWN_RANGE * 0.9f);
+}
+
+// A few hundred asteroids spread over the same area, the open-space case
+static void SetupSparse(AppState *s) {
+  FillAsteroids(s, BENCH_SPARSE_ASTEROIDS, SPAWN_SAFE_ZONE, DESPAWN_RANGE * 0.9f);
+}
+
+static void TickSparse(AppState *s, int tick) {
+  (void)tick;
+  FillAsteroids(s, BENCH_SPARSE_ASTEROIDS - s->world.asteroid_count, SPAWN_SAFE_ZONE, DESPAWN_RANGE * 0.9f);
+}
+
+// Full unit cap of fighters on offensive behavior with targets around them; losses are replaced
+static void SetupFighters(AppState *s) {
+  while (Headless_SpawnUnit(s, UNIT_FIGHTER, RandRing(s, 400.0f, 3000.0f), BEHAVIOR_OFFENSIVE) != -1) {}
+  FillAsteroids(s, 300, SPAWN_MIN_DIST, DESPAWN_RANGE * 0.9f);
+}
+
+static void TickFighters(AppState *s, int tick) {
+  (void)tick;
+  while (Headless_SpawnUnit(s, UNIT_FIGHTER, RandRing(s, 400.0f, 3000.0f), BEHAVIOR_OFFENSIVE) != -1) {}
+}
+
+// Chained explosions keep the particle ring saturated
+static void SetupParticleStorm(AppState *s) { (void)s; }
+
+static void TickParticleStorm(AppState *s, int tick) {
+  for (int i = 0; i < 8; i++)
+    Particles_SpawnExplosion(s, RandRing(s, 0.0f, 4000.0f), 40, RandRange(s, 1.0f, 4.0f), (tick + i) % 2 ? EXPLOSION_COLLISION : EXPLOSION_IMPACT, Rng_Int(&s->world.rng_sim, ASTEROID_TYPE_COUNT));
+}
+
+// Miners at the unit cap, all carrying a full hold, with every crystal slot filled
+static void TickMining(AppState *s, int tick) {
+  (void)tick;
+  int idx;
+  while ((idx = Headless_SpawnUnit(s, UNIT_MINER, RandRing(s, 600.0f, 3000.0f), BEHAVIOR_OFFENSIVE)) != -1)
+    s->world.units.current_cargo[idx] = s->world.units.stats[idx]->max_cargo;
+}
+
+static void SetupMining(AppState *s) {
+  TickMining(s, 0);
+  while (s->world.resource_count < MAX_RESOURCES) {
+    float angle = RandRange(s, 0.0f, 2.0f * SDL_PI_F);
+    SpawnCrystal(s, RandRing(s, SPAWN_SAFE_ZONE, 7000.0f), (Vec2){cosf(angle), sinf(angle)}, RandRange(s, CRYSTAL_RADIUS_LARGE_MIN, CRYSTAL_RADIUS_LARGE_MIN + CRYSTAL_RADIUS_LARGE_VARIANCE));
+  }
+}
+
+static const Scenario scenarios[] = {
+    {"belt", SetupBelt, TickBelt},
+    {"sparse", SetupSparse, TickSparse},
+    {"fighters", SetupFighters, TickFighters},
+    {"particle_storm", SetupParticleStorm, TickParticleStorm},
+    {"mining", SetupMining, TickMining},
+};
+
+static int CompareDouble(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static double Percentile(const double *sorted, int n, double p) {
+  int idx = (int)ceil(p * n) - 1;
+  if (idx < 0) idx = 0;
+  if (idx >= n) idx = n - 1;
+  return sorted[idx];
+}
+
+// Asteroid-pair broadphase totals for the A/B mode
+typedef struct {
+  double ms;
+  long long candidates, overlaps, shifts;
+} BroadphaseTally;
+
+// Scratch for the A/B mode, kept apart from the world so the measured run is undisturbed
+typedef struct {
+  SpatialGrid grid;
+  SweepState sweep;
+  BroadphaseTally tally[BROADPHASE_COUNT];
+  int mismatch_ticks; // Ticks where the two disagreed on overlapping pairs
+} BroadphaseAB;
+
+static bool HitboxesOverlap(const AppState *s, int i, int j) {
+  float r = (s->world.asteroids.radius[i] + s->world.asteroids.radius[j]) * ASTEROID_HITBOX_MULT;
+  return Vector_DistanceSq(s->world.asteroids.pos[i], s->world.asteroids.pos[j]) < r * r;
+}
+
+static double MsSince(Uint64 start) { return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency(); }
+
+// Both broadphases see the world exactly as the tick left it; timings include the shared narrow test
+static void MeasureBroadphases(const AppState *s, BroadphaseAB *ab) {
+  int ids[SPATIAL_MAX_IDS];
+  long long overlaps[BROADPHASE_COUNT] = {0, 0};
+
+  BroadphaseTally *gt = &ab->tally[BROADPHASE_GRID];
+  Uint64 start = SDL_GetPerformanceCounter();
+  Spatial_Build(s, &ab->grid);
+  for (int i = 0; i < MAX_ASTEROIDS; i++) {
+    if (!Spatial_AsteroidCollides(&s->world.asteroids, i)) continue;
+    Vec2 p = s->world.asteroids.pos[i];
+    float r = s->world.asteroids.radius[i] * ASTEROID_HITBOX_MULT;
+    int n = Spatial_QueryAABB(s, &ab->grid, p.x - r, p.y - r, p.x + r, p.y + r, SPATIAL_MASK(SPATIAL_ASTEROID), ids, SPATIAL_MAX_IDS);
+    for (int k = 0; k < n; k++) {
+      if (ids[k] <= i || !Spatial_AsteroidCollides(&s->world.asteroids, ids[k])) continue;
+      gt->candidates++;
+      if (HitboxesOverlap(s, i, ids[k])) overlaps[BROADPHASE_GRID]++;
+    }
+  }
+  gt->ms += MsSince(start);
+
+  BroadphaseTally *st = &ab->tally[BROADPHASE_SAP];
+  start = SDL_GetPerformanceCounter();
+  int pairs = Spatial_SweepPairs(s, &ab->sweep);
+  for (int k = 0; k < pairs; k++)
+    if (HitboxesOverlap(s, (int)(ab->sweep.pairs[k] >> 16), (int)(ab->sweep.pairs[k] & 0xFFFF))) overlaps[BROADPHASE_SAP]++;
+  st->ms += MsSince(start);
+  st->candidates += pairs < 0 ? 0 : pairs;
+  st->shifts += ab->sweep.shifts;
+
+  for (int m = 0; m < BROADPHASE_COUNT; m++) ab->tally[m].overlaps += overlaps[m];
+  if (pairs < 0 || overlaps[BROADPHASE_GRID] != overlaps[BROADPHASE_SAP]) ab->mismatch_ticks++;
+}
+
+static void RunScenario(FILE *out, const Scenario *sc, AppState *s, unsigned int seed, BroadphaseMode broadphase, int jobs, int warmup, int ticks, double *samples[BENCH_ZONE_COUNT], BroadphaseAB *ab, bool first) {
+  SDL_memset(s, 0, sizeof(AppState));
+  Headless_Init(s, seed, 1280, 720);
+  s->world.broadphase = broadphase;
+  Jobs_Start(&s->jobs, jobs); // After the memset, which would orphan a running pool
+  sc->setup(s);
+  if (ab) SDL_memset(ab, 0, sizeof(BroadphaseAB));
+
+  for (int t = 0; t < warmup + ticks; t++) {
+    if (sc->tick) sc->tick(s, t);
+    Headless_Step(s, s->sim_dt);
+    if (ab) MeasureBroadphases(s, ab); // Every tick so the sweep order stays as coherent as in play
+    if (t >= warmup)
+      for (int z = 0; z < BENCH_ZONE_COUNT; z++) samples[z][t - warmup] = Profiler_GetZoneMs(s, bench_zones[z]);
+  }
+  Jobs_Stop(&s->jobs);
+
+  int active_particles = 0, tiers[3] = {0, 0, 0};
+  BITS_FOR_EACH(i, s->world.particles.active, MAX_PARTICLES) active_particles++;
+  BITS_FOR_EACH(i, s->world.asteroids.active, MAX_ASTEROIDS) tiers[s->world.asteroids.tier[i]]++;
+
+  fprintf(out, "%s    {\n      \"name\": \"%s\",\n      \"warmup\": %d,\n      \"ticks\": %d,\n", first ? "" : ",\n", sc->name, warmup, ticks);
+  fprintf(out, "      \"final_counts\": {\"asteroids\": %d, \"units\": %d, \"resources\": %d, \"particles\": %d},\n", s->world.asteroid_count, s->world.unit_count, s->world.resource_count, active_particles);
+  fprintf(out, "      \"asteroid_tiers\": {\"full\": %d, \"drift\": %d, \"sleep\": %d},\n", tiers[SIM_TIER_FULL], tiers[SIM_TIER_DRIFT], tiers[SIM_TIER_SLEEP]);
+  fprintf(out, "      \"final_hash\": \"%016" SDL_PRIx64 "\",\n", s->world.state_hash);
+  fprintf(out, "      \"zones\": {\n");
+  for (int z = 0; z < BENCH_ZONE_COUNT; z++) {
+    double sum = 0.0;
+    for (int t = 0; t < ticks; t++) sum += samples[z][t];
+    SDL_qsort(samples[z], ticks, sizeof(double), CompareDouble);
+    fprintf(out, "        \"%s\": {\"mean_ms\": %.5f, \"p50_ms\": %.5f, \"p99_ms\": %.5f, \"max_ms\": %.5f}%s\n", Profiler_GetZoneInfo(bench_zones[z])->name, sum / ticks,
+            Percentile(samples[z], ticks, 0.50), Percentile(samples[z], ticks, 0.99), samples[z][ticks - 1], z + 1 < BENCH_ZONE_COUNT ? "," : "");
+  }
+  fprintf(out, "      }");
+  if (ab) {
+    int n = warmup + ticks;
+    fprintf(out, ",\n      \"broadphase_ab\": {\n");
+    for (int m = 0; m < BROADPHASE_COUNT; m++) {
+      const BroadphaseTally *bt = &ab->tally[m];
+      fprintf(out, "        \"%s\": {\"mean_ms\": %.5f, \"mean_candidates\": %.1f, \"mean_overlaps\": %.1f", Spatial_BroadphaseName((BroadphaseMode)m), bt->ms / n,
+              (double)bt->candidates / n, (double)bt->overlaps / n);
+      if (m == BROADPHASE_SAP) fprintf(out, ", \"mean_sort_shifts\": %.1f", (double)bt->shifts / n);
+      fprintf(out, "},\n");
+    }
+    fprintf(out, "        \"mismatch_ticks\": %d\n      }", ab->mismatch_ticks);
+  }
+  fprintf(out, "\n    }");
+}
+
+static void PrintUsage(const char *exe) {
+  printf("usage: %s [--seed N] [--warmup N] [--ticks N] [--scenario NAME] [--broadphase grid|sap] [--broadphase-ab] [--jobs N] [--out FILE]\n", exe);
+  printf("scenarios:");
+  for (size_t i = 0; i < SDL_arraysize(scenarios); i++) printf(" %s", scenarios[i].name);
+  printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+  unsigned int seed = 1;
+  int warmup = 120, ticks = 600;
+  const char *only = NULL, *out_path = NULL;
+  BroadphaseMode broadphase = BROADPHASE_GRID;
+  int jobs = Jobs_DefaultWorkerCount();
+  bool run_ab = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (SDL_strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = (unsigned int)SDL_strtoull(argv[++i], NULL, 10);
+    else if (SDL_strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) warmup = SDL_atoi(argv[++i]);
+    else if (SDL_strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticks = SDL_atoi(argv[++i]);
+    else if (SDL_strcmp(argv[i], "--scenario") == 0 && i + 1 < argc) only = argv[++i];
+    else if (SDL_strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+    else if (SDL_strcmp(argv[i], "--broadphase") == 0 && i + 1 < argc) {
+      if (!Spatial_ParseBroadphase(argv[++i], &broadphase)) { PrintUsage(argv[0]); return 1; }
+    }
+    else if (SDL_strcmp(argv[i], "--broadphase-ab") == 0) run_ab = true;
+    else if (SDL_strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) jobs = SDL_atoi(argv[++i]);
+    else { PrintUsage(argv[0]); return 1; }
+  }
+  if (ticks <= 0 || warmup < 0) { PrintUsage(argv[0]); return 1; }
+
+  if (!SDL_Init(0)) return 1;
+  FILE *out = out_path ? fopen(out_path, "w") : stdout;
+  if (!out) return 1;
+
+  AppState *s = SDL_aligned_alloc(_Alignof(AppState), sizeof(AppState)); // RunScenario clears it
+  double *samples[BENCH_ZONE_COUNT];
+  for (int z = 0; z < BENCH_ZONE_COUNT; z++) samples[z] = SDL_malloc(sizeof(double) * ticks);
+  BroadphaseAB *ab = run_ab ? SDL_malloc(sizeof(BroadphaseAB)) : NULL;
+
+  fprintf(out, "{\n  \"seed\": %u,\n  \"tick_rate\": %d,\n  \"broadphase\": \"%s\",\n  \"jobs\": %d,\n  \"scenarios\": [\n", seed, SIM_TICK_RATE, Spatial_BroadphaseName(broadphase), jobs);
+  bool first = true;
+  for (size_t i = 0; i < SDL_arraysize(scenarios); i++) {
+    if (only && SDL_strcmp(only, scenarios[i].name) != 0) continue;
+    RunScenario(out, &scenarios[i], s, seed, broadphase, jobs, warmup, ticks, samples, ab, first);
+    first = false;
+  }
+  fprintf(out, "\n  ]\n}\n");
+
+  for (int z = 0; z < BENCH_ZONE_COUNT; z++) SDL_free(samples[z]);
+  SDL_free(ab);
+  SDL_aligned_free(s);
+  if (out != stdout) fclose(out);
+  SDL_Quit();
+  return 0;
+}
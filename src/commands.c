@@ -0,0 +1,115 @@
+#include "commands.h"
+#include "constants.h"
+#include "game.h"
+#include "physics.h"
+#include "rng.h"
+#include "slots.h"
+#include "utils.h"
+#include <math.h>
+
+static WorldCommand *Push(AppState *s, WorldCommandType type) {
+  CommandQueue *q = &s->world.commands;
+  if (q->count >= COMMAND_QUEUE_SIZE) {
+    s->counters.commands_dropped++;
+    return NULL;
+  }
+  WorldCommand *c = &q->cmds[q->count++];
+  SDL_memset(c, 0, sizeof(WorldCommand));
+  c->type = type;
+  return c;
+}
+
+void Commands_SplitAsteroid(AppState *s, int idx) {
+  WorldCommand *c = Push(s, COMMAND_SPLIT_ASTEROID);
+  if (c) c->idx = idx;
+}
+
+void Commands_DestroyAsteroid(AppState *s, int idx, bool blast) {
+  WorldCommand *c = Push(s, COMMAND_DESTROY_ASTEROID);
+  if (!c) return;
+  c->idx = idx;
+  c->blast = blast;
+  Bits_Set(s->world.commands.destroy_pending, idx);
+}
+
+bool Commands_DestroyPending(const AppState *s, int idx) { return Bits_Test(s->world.commands.destroy_pending, idx); }
+
+void Commands_SpawnCrystal(AppState *s, Vec2 pos, Vec2 vel_dir, float radius) {
+  WorldCommand *c = Push(s, COMMAND_SPAWN_CRYSTAL);
+  if (!c) return;
+  c->pos = pos;
+  c->vel = vel_dir;
+  c->radius = radius;
+}
+
+static void PushBlast(AppState *s, AreaBlast b) {
+  CommandQueue *q = &s->world.commands;
+  if (q->blast_count >= COMMAND_QUEUE_SIZE) {
+    s->counters.commands_dropped++;
+    return;
+  }
+  q->blasts[q->blast_count++] = b;
+}
+
+void Commands_AreaDamage(AppState *s, Vec2 pos, float range, float damage, int exclude_unit_idx) {
+  PushBlast(s, (AreaBlast){pos, range, damage, 1.0f, 0.5f, true, true, exclude_unit_idx, -1});
+}
+
+void Commands_FlatDamage(AppState *s, Vec2 pos, float range, float damage, float unit_mult, float asteroid_mult, int exclude_asteroid_idx) {
+  PushBlast(s, (AreaBlast){pos, range, damage, unit_mult, asteroid_mult, false, false, -1, exclude_asteroid_idx});
+}
+
+static void ApplySplit(AppState *s, int idx) {
+  if (!Bits_Test(s->world.asteroids.active, idx) || s->world.asteroids.radius[idx] <= ASTEROID_SPLIT_MIN_RADIUS) return;
+  float old_rad = s->world.asteroids.radius[idx];
+  float new_rad = old_rad * ASTEROID_SPLIT_EXPONENT;
+  Vec2 pos = s->world.asteroids.pos[idx];
+  Vec2 vel = s->world.asteroids.velocity[idx];
+
+  Slots_FreeAsteroid(s, idx);
+
+  Physics_EmitEvent(s, COLLISION_ASTEROID_SPLIT, idx, -1, pos, old_rad, s->world.asteroids.tex_idx[idx]);
+
+  // Two smaller fragments, spawned at the tail of the queue
+  for (int f = 0; f < 2; f++) {
+    float angle = Rng_Float(&s->world.rng_sim) * 2.0f * 3.14159f;
+    Vec2 off = {cosf(angle) * new_rad, sinf(angle) * new_rad};
+    WorldCommand *c = Push(s, COMMAND_SPAWN_ASTEROID);
+    if (!c) return;
+    c->pos = (Vec2){pos.x + off.x, pos.y + off.y};
+    c->vel = Vector_Normalize((Vec2){vel.x + off.x * 0.5f, vel.y + off.y * 0.5f});
+    c->radius = new_rad;
+  }
+}
+
+static void ApplyDestroy(AppState *s, int idx, bool blast) {
+  if (!Bits_Test(s->world.asteroids.active, idx)) return;
+  float rad = s->world.asteroids.radius[idx];
+  Vec2 pos = s->world.asteroids.pos[idx];
+
+  Slots_FreeAsteroid(s, idx);
+
+  Physics_EmitEvent(s, COLLISION_ASTEROID_DESTROYED, idx, -1, pos, rad, s->world.asteroids.tex_idx[idx]);
+  if (blast) Commands_AreaDamage(s, pos, rad * 2.5f, rad * 50.0f, -1);
+}
+
+void Commands_Flush(AppState *s) {
+  CommandQueue *q = &s->world.commands;
+  // Removals first; count grows as splits queue their fragments
+  for (int k = 0; k < q->count; k++) {
+    const WorldCommand *c = &q->cmds[k];
+    if (c->type == COMMAND_SPLIT_ASTEROID) ApplySplit(s, c->idx);
+    else if (c->type == COMMAND_DESTROY_ASTEROID) ApplyDestroy(s, c->idx, c->blast);
+  }
+  Bits_ClearAll(q->destroy_pending, MAX_ASTEROIDS);
+  // Then every blast of the flush in one batch, which fragments don't take part in
+  Physics_ApplyBlasts(s, q->blasts, q->blast_count);
+  for (int k = 0; k < q->count; k++) {
+    const WorldCommand *c = &q->cmds[k];
+    if (c->type == COMMAND_SPAWN_ASTEROID) SpawnAsteroid(s, c->pos, c->vel, c->radius);
+    else if (c->type == COMMAND_SPAWN_CRYSTAL) SpawnCrystal(s, c->pos, c->vel, c->radius);
+  }
+  s->counters.commands_applied += q->count + q->blast_count;
+  q->count = 0;
+  q->blast_count = 0;
+}
@@ -0,0 +1,34 @@
+#include "counters.h"
+
+bool Counters_Open(AppState *s, const char *filename) {
+  s->counters.csv = fopen(filename, "w");
+  if (!s->counters.csv) return false;
+  fprintf(s->counters.csv, "tick,ms,asteroids,units,resources,collision_pairs_tested,collision_pairs_resolved,spawn_attempts,spawn_rejections,"
+                           "particles_allocated,particles_overwritten,targeting_candidates,commands_applied,commands_dropped,events_dropped,draw_calls\n");
+  return true;
+}
+
+void Counters_BeginTick(AppState *s) {
+  WorkCounters *c = &s->counters;
+  c->collision_pairs_tested = c->collision_pairs_resolved = 0;
+  c->spawn_attempts = c->spawn_rejections = 0;
+  c->particles_allocated = c->particles_overwritten = 0;
+  c->commands_applied = c->commands_dropped = 0;
+}
+
+// One CSV row per tick; draw_calls is from the last rendered frame
+void Counters_EndTick(AppState *s, double ms) {
+  WorkCounters *c = &s->counters;
+  if (c->csv) {
+    fprintf(c->csv, "%d,%.4f,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d\n", c->tick, ms, s->world.asteroid_count, s->world.unit_count, s->world.resource_count,
+            c->collision_pairs_tested, c->collision_pairs_resolved, c->spawn_attempts, c->spawn_rejections, c->particles_allocated, c->particles_overwritten,
+            SDL_GetAtomicInt(&c->targeting_candidates), c->commands_applied, c->commands_dropped,
+            s->world.collision_events.dropped, c->draw_calls);
+  }
+  c->tick++;
+}
+
+void Counters_Close(AppState *s) {
+  if (s->counters.csv) fclose(s->counters.csv);
+  s->counters.csv = NULL;
+}
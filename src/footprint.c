@@ -0,0 +1,58 @@
+#include "footprint.h"
+
+#define FIELD(type, member) sizeof(((type *)0)->member[0])
+#define KB(bytes) ((double)(bytes) / 1024.0)
+
+// Per-slot bytes the tick touches for an active entity; cold data (max_health, tex_idx, production) is left out
+static size_t UnitHotBytes(void) {
+  return FIELD(UnitPool, pos) + FIELD(UnitPool, prev_pos) + FIELD(UnitPool, velocity) + FIELD(UnitPool, rotation) + FIELD(UnitPool, prev_rotation) +
+         FIELD(UnitPool, health) + FIELD(UnitPool, energy) + FIELD(UnitPool, current_cargo) + FIELD(UnitPool, type) + FIELD(UnitPool, stats) +
+         FIELD(UnitPool, mining_cooldown) + FIELD(UnitOrderPool, count) + FIELD(UnitOrderPool, current_idx) + FIELD(UnitOrderPool, has_target) +
+         FIELD(UnitOrderPool, behavior) + sizeof(Command) + FIELD(UnitTargetPool, large) + FIELD(UnitTargetPool, small) +
+         FIELD(UnitTargetPool, large_cooldown) + FIELD(UnitTargetPool, small_cooldown);
+}
+
+static size_t AsteroidHotBytes(void) {
+  return FIELD(AsteroidPool, pos) + FIELD(AsteroidPool, prev_pos) + FIELD(AsteroidPool, velocity) + FIELD(AsteroidPool, radius) +
+         FIELD(AsteroidPool, rotation) + FIELD(AsteroidPool, prev_rotation) + FIELD(AsteroidPool, rot_speed) + FIELD(AsteroidPool, health);
+}
+
+static size_t ResourceHotBytes(void) {
+  return FIELD(ResourcePool, pos) + FIELD(ResourcePool, prev_pos) + FIELD(ResourcePool, velocity) + FIELD(ResourcePool, radius) +
+         FIELD(ResourcePool, rotation) + FIELD(ResourcePool, prev_rotation) + FIELD(ResourcePool, rot_speed) + FIELD(ResourcePool, health) +
+         FIELD(ResourcePool, amount);
+}
+
+static size_t ParticleHotBytes(void) {
+  return FIELD(ParticlePool, pos_x) + FIELD(ParticlePool, pos_y) + FIELD(ParticlePool, prev_x) + FIELD(ParticlePool, prev_y) +
+         FIELD(ParticlePool, vel_x) + FIELD(ParticlePool, vel_y) + FIELD(ParticlePool, life) +
+         FIELD(ParticlePool, size) + FIELD(ParticlePool, type);
+}
+
+// Every tick scans the full occupancy bitsets, however few slots are live, and clears the targeted bits
+static size_t FlagScanBytes(void) {
+  return sizeof(((UnitPool *)0)->active) + sizeof(((AsteroidPool *)0)->active) + sizeof(((ResourcePool *)0)->active) +
+         sizeof(((ParticlePool *)0)->active) + sizeof(((AsteroidPool *)0)->targeted);
+}
+
+static size_t WorkingSet(int units, int asteroids, int resources, int particles) {
+  return FlagScanBytes() + (size_t)units * UnitHotBytes() + (size_t)asteroids * AsteroidHotBytes() + (size_t)resources * ResourceHotBytes() +
+         (size_t)particles * ParticleHotBytes();
+}
+
+size_t Footprint_TickWorkingSet(const AppState *s) {
+  return WorkingSet(s->world.unit_count, s->world.asteroid_count, s->world.resource_count, s->world.slots.particles.live_count);
+}
+
+void Footprint_LogReport(const AppState *s) {
+  SDL_Log("AppState %.1f KB: world %.1f KB, profiler %.1f KB, trace %.1f KB, frame stats %.1f KB", KB(sizeof(AppState)), KB(sizeof(WorldState)),
+          KB(sizeof(ProfilerState)), KB(sizeof(TraceState)), KB(sizeof(FrameStatsState)));
+  SDL_Log("  asteroids %.1f KB, units %.1f KB, targets %.1f KB, production %.1f KB", KB(sizeof(AsteroidPool)), KB(sizeof(UnitPool)),
+          KB(sizeof(UnitTargetPool)), KB(sizeof(ProductionPool)));
+  SDL_Log("  particles %.1f KB, tracers %.1f KB, resources %.1f KB", KB(sizeof(ParticlePool)), KB(sizeof(TracerPool)), KB(sizeof(ResourcePool)));
+  SDL_Log("  hot bytes per slot: unit %zu, asteroid %zu, resource %zu, particle %zu; flag scans %zu", UnitHotBytes(), AsteroidHotBytes(),
+          ResourceHotBytes(), ParticleHotBytes(), FlagScanBytes());
+  SDL_Log("  tick working set at capacity %.1f KB", KB(WorkingSet(MAX_UNITS, MAX_ASTEROIDS, MAX_RESOURCES, MAX_PARTICLES)));
+  SDL_Log("  tick working set now %.1f KB: %d units, %d asteroids, %d resources, %d particles", KB(Footprint_TickWorkingSet(s)), s->world.unit_count,
+          s->world.asteroid_count, s->world.resource_count, s->world.slots.particles.live_count);
+}
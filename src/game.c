@@ -7,6 +7,14 @@
 #include "weapons.h"
 #include "abilities.h"
 #include "ai.h"
+#include "profiler.h"
+#include "counters.h"
+#include "statehash.h"
+#include "rng.h"
+#include "spatial.h"
+#include "commands.h"
+#include "slots.h"
+#include <float.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -15,62 +23,54 @@ static void UpdateRadar(AppState *s);
 static void UpdateSpawning(AppState *s, Vec2 cam_center);
 
 void SpawnAsteroid(AppState *s, Vec2 pos, Vec2 vel_dir, float radius) {
-  if (s->world.asteroid_count >= MAX_ASTEROIDS)
+  int i = Slots_AllocAsteroid(s);
+  if (i < 0)
     return;
-  for (int i = 0; i < MAX_ASTEROIDS; i++) {
-    if (!s->world.asteroids.active[i]) {
-      s->world.asteroids.pos[i] = pos;
-      float speed = ASTEROID_SPEED_FACTOR / radius;
-      s->world.asteroids.velocity[i].x = vel_dir.x * speed;
-      s->world.asteroids.velocity[i].y = vel_dir.y * speed;
-      s->world.asteroids.radius[i] = radius;
-      s->world.asteroids.rotation[i] = (float)(rand() % 360);
-      s->world.asteroids.rot_speed[i] =
-          ((float)(rand() % 100) / 50.0f - 1.0f) *
-          (ASTEROID_ROTATION_SPEED_FACTOR / radius);
-      s->world.asteroids.tex_idx[i] = rand() % ASTEROID_TYPE_COUNT;
-      s->world.asteroids.active[i] = true;
-      // Make smaller asteroids exponentially weaker
-      float health_scale = powf(radius / 1000.0f, 1.5f) * 1000.0f;
-      s->world.asteroids.max_health[i] = health_scale * ASTEROID_HEALTH_MULT * 0.2f; // Increased health
-      s->world.asteroids.health[i] = s->world.asteroids.max_health[i];
-      s->world.asteroids.targeted[i] = false;
-      s->world.asteroid_count++;
-      break;
-    }
-  }
+  s->world.asteroids.pos[i] = pos;
+  s->world.asteroids.prev_pos[i] = pos;
+  float speed = ASTEROID_SPEED_FACTOR / radius;
+  s->world.asteroids.velocity[i].x = vel_dir.x * speed;
+  s->world.asteroids.velocity[i].y = vel_dir.y * speed;
+  s->world.asteroids.radius[i] = radius;
+  s->world.asteroids.rotation[i] = (float)Rng_Int(&s->world.rng_sim, 360);
+  s->world.asteroids.prev_rotation[i] = s->world.asteroids.rotation[i];
+  s->world.asteroids.rot_speed[i] =
+      ((float)Rng_Int(&s->world.rng_sim, 100) / 50.0f - 1.0f) *
+      (ASTEROID_ROTATION_SPEED_FACTOR / radius);
+  s->world.asteroids.tex_idx[i] = Rng_Int(&s->world.rng_sim, ASTEROID_TYPE_COUNT);
+  // Make smaller asteroids exponentially weaker
+  float health_scale = powf(radius / 1000.0f, 1.5f) * 1000.0f;
+  s->world.asteroids.max_health[i] = health_scale * ASTEROID_HEALTH_MULT * 0.2f; // Increased health
+  s->world.asteroids.health[i] = s->world.asteroids.max_health[i];
+  Bits_Clear(s->world.asteroids.targeted, i);
+  s->world.asteroids.tier[i] = SIM_TIER_FULL;
+  s->world.asteroids.drift_dt[i] = 0.0f;
 }
 
 void SpawnCrystal(AppState *s, Vec2 pos, Vec2 vel_dir, float radius) {
-    if (s->world.resource_count >= MAX_RESOURCES) return;
-    for (int i = 0; i < MAX_RESOURCES; i++) {
-        if (!s->world.resources.active[i]) {
-            s->world.resources.pos[i] = pos;
-            float speed = (ASTEROID_SPEED_FACTOR * 0.1f) / radius; // Crystals drift very slowly
-            s->world.resources.velocity[i].x = vel_dir.x * speed;
-            s->world.resources.velocity[i].y = vel_dir.y * speed;
-            s->world.resources.radius[i] = radius;
-            s->world.resources.rotation[i] = (float)(rand() % 360);
-            s->world.resources.rot_speed[i] =
-                ((float)(rand() % 100) / 50.0f - 1.0f) *
-                (ASTEROID_ROTATION_SPEED_FACTOR * 0.1f / radius); // Slow rotation
-            s->world.resources.amount[i] = radius * CRYSTAL_VALUE_MULT;
-            s->world.resources.max_health[i] = radius * CRYSTAL_VALUE_MULT * 2.0f; // Increased health
-            s->world.resources.health[i] = s->world.resources.max_health[i];
-            s->world.resources.tex_idx[i] = rand() % CRYSTAL_COUNT;
-            s->world.resources.active[i] = true;
-            s->world.resource_count++;
-            break;
-        }
-    }
+    int i = Slots_AllocResource(s);
+    if (i < 0) return;
+    s->world.resources.pos[i] = pos;
+    s->world.resources.prev_pos[i] = pos;
+    float speed = (ASTEROID_SPEED_FACTOR * 0.1f) / radius; // Crystals drift very slowly
+    s->world.resources.velocity[i].x = vel_dir.x * speed;
+    s->world.resources.velocity[i].y = vel_dir.y * speed;
+    s->world.resources.radius[i] = radius;
+    s->world.resources.rotation[i] = (float)Rng_Int(&s->world.rng_sim, 360);
+    s->world.resources.prev_rotation[i] = s->world.resources.rotation[i];
+    s->world.resources.rot_speed[i] =
+        ((float)Rng_Int(&s->world.rng_sim, 100) / 50.0f - 1.0f) *
+        (ASTEROID_ROTATION_SPEED_FACTOR * 0.1f / radius); // Slow rotation
+    s->world.resources.amount[i] = radius * CRYSTAL_VALUE_MULT;
+    s->world.resources.max_health[i] = radius * CRYSTAL_VALUE_MULT * 2.0f; // Increased health
+    s->world.resources.health[i] = s->world.resources.max_health[i];
+    s->world.resources.tex_idx[i] = Rng_Int(&s->world.rng_sim, CRYSTAL_COUNT);
 }
 
 static void UpdateSimAnchors(AppState *s, Vec2 cam_center) {
   s->world.sim_anchor_count = 0;
   s->world.sim_anchors[s->world.sim_anchor_count++].pos = cam_center;
-  for (int i = 0; i < MAX_UNITS; i++) {
-    if (!s->world.units.active[i])
-      continue;
+  BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) {
     if (s->world.sim_anchor_count >= MAX_SIM_ANCHORS)
       break;
     bool covered = false;
@@ -88,6 +88,12 @@ static void UpdateSimAnchors(AppState *s, Vec2 cam_center) {
   }
 }
 
+void Game_Seed(AppState *s, Uint64 seed) {
+  s->world.seed = seed;
+  Rng_Seed(&s->world.rng_sim, seed, RNG_STREAM_SIM);
+  Rng_Seed(&s->world.rng_vfx, seed, RNG_STREAM_VFX);
+}
+
 void Game_Init(AppState *s) {
   // Mothership Stats
   s->world.unit_stats[UNIT_MOTHERSHIP] =
@@ -189,6 +195,9 @@ void Game_Init(AppState *s) {
                   .laser_start_offset_mult = 4.5f};
 
   SDL_memset(&s->world.units, 0, sizeof(UnitPool));
+  SDL_memset(&s->world.orders, 0, sizeof(UnitOrderPool));
+  SDL_memset(&s->world.targets, 0, sizeof(UnitTargetPool));
+  SDL_memset(&s->world.production, 0, sizeof(ProductionPool));
   s->world.unit_count = 0;
   s->world.energy = INITIAL_ENERGY;
   s->world.stored_resources = 500.0f; // Starting resources
@@ -202,13 +211,13 @@ void Game_Init(AppState *s) {
   s->world.resource_count = 0;
 
   for (int i = 0; i < MAX_UNITS; i++) {
-    s->world.units.active[i] = false;
-    s->world.units.production_mode[i] = UNIT_TYPE_COUNT;
+    Bits_Clear(s->world.units.active, i);
+    s->world.production.mode[i] = UNIT_TYPE_COUNT;
   }
 
   // Create starting Mothership
   int idx = 0;
-  s->world.units.active[idx] = true;
+  Bits_Set(s->world.units.active, idx);
   s->world.units.type[idx] = UNIT_MOTHERSHIP;
   s->world.units.stats[idx] = &s->world.unit_stats[UNIT_MOTHERSHIP];
   s->world.units.pos[idx] = (Vec2){0, 0};
@@ -217,28 +226,39 @@ void Game_Init(AppState *s) {
   s->world.units.health[idx] = s->world.units.stats[idx]->max_health;
   s->world.units.energy[idx] = s->world.units.stats[idx]->max_energy;
   s->world.units.current_cargo[idx] = 0.0f;
-  s->world.units.behavior[idx] = BEHAVIOR_DEFENSIVE;
-  s->world.units.command_count[idx] = 0;
-  s->world.units.command_current_idx[idx] = 0;
-  s->world.units.has_target[idx] = false;
-  s->world.units.large_target_idx[idx] = -1;
+  s->world.orders.behavior[idx] = BEHAVIOR_DEFENSIVE;
+  s->world.orders.count[idx] = 0;
+  s->world.orders.current_idx[idx] = 0;
+  s->world.orders.has_target[idx] = false;
+  s->world.targets.large[idx] = -1;
   s->world.units.mining_cooldown[idx] = 0.0f;
-  s->world.units.production_mode[idx] = UNIT_TYPE_COUNT;
+  s->world.production.mode[idx] = UNIT_TYPE_COUNT;
   for (int c = 0; c < 4; c++)
-    s->world.units.small_target_idx[idx][c] = -1;
-  s->world.unit_count = 1;
+    s->world.targets.small[idx][c] = -1;
+  Slots_Rebuild(s); // Also sets the counts
 
   s->selection.primary_unit_idx = 0;
-  SDL_memset(s->selection.unit_selected, 0, sizeof(s->selection.unit_selected));
-  s->selection.unit_selected[0] = true;
+  Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
+  Bits_Set(s->selection.unit_selected, 0);
 
   // Initialize Camera
-  int win_w, win_h;
-  SDL_GetRenderOutputSize(s->renderer, &win_w, &win_h);
+  int win_w = s->camera.view_w, win_h = s->camera.view_h;
   s->camera.zoom = MIN_ZOOM;
   s->camera.shake_intensity = 0.0f;
   s->camera.pos.x = s->world.units.pos[idx].x - (win_w / 2.0f) / s->camera.zoom;
   s->camera.pos.y = s->world.units.pos[idx].y - (win_h / 2.0f) / s->camera.zoom;
+  Game_SnapshotState(s);
+}
+
+// Copies current transforms into prev_* so the renderer can blend towards the next tick
+void Game_SnapshotState(AppState *s) {
+  SDL_memcpy(s->world.asteroids.prev_pos, s->world.asteroids.pos, sizeof(s->world.asteroids.pos));
+  SDL_memcpy(s->world.asteroids.prev_rotation, s->world.asteroids.rotation, sizeof(s->world.asteroids.rotation));
+  SDL_memcpy(s->world.resources.prev_pos, s->world.resources.pos, sizeof(s->world.resources.pos));
+  SDL_memcpy(s->world.resources.prev_rotation, s->world.resources.rotation, sizeof(s->world.resources.rotation));
+  SDL_memcpy(s->world.units.prev_pos, s->world.units.pos, sizeof(s->world.units.pos));
+  SDL_memcpy(s->world.units.prev_rotation, s->world.units.rotation, sizeof(s->world.units.rotation));
+  s->camera.prev_pos = s->camera.pos;
 }
 
 static void HandleRespawn(AppState *s, float dt, int win_w, int win_h) {
@@ -249,26 +269,22 @@ static void HandleRespawn(AppState *s, float dt, int win_w, int win_h) {
   // During countdown, keep camera near respawn point or death point
   s->camera.pos.x = s->ui.respawn_pos.x - (win_w / 2.0f) / s->camera.zoom;
   s->camera.pos.y = s->ui.respawn_pos.y - (win_h / 2.0f) / s->camera.zoom;
+  s->camera.prev_pos = s->camera.pos; // Jumps snap, don't blend them
 
   if (s->ui.respawn_timer <= 0) {
     int m_idx = -1;
     for (int i = 0; i < MAX_UNITS; i++) {
-        if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) {
+        if (Bits_Test(s->world.units.active, i) && s->world.units.type[i] == UNIT_MOTHERSHIP) {
             m_idx = i; break;
         }
     }
     
-    // If no mothership, find a free slot
+    // If no mothership, claim a free slot
     if (m_idx == -1) {
-        for (int i = 0; i < MAX_UNITS; i++) {
-            if (!s->world.units.active[i]) {
-                m_idx = i;
-                s->world.units.active[m_idx] = true;
-                s->world.units.type[m_idx] = UNIT_MOTHERSHIP;
-                s->world.units.stats[m_idx] = &s->world.unit_stats[UNIT_MOTHERSHIP];
-                s->world.unit_count++;
-                break;
-            }
+        m_idx = Slots_AllocUnit(s);
+        if (m_idx != -1) {
+            s->world.units.type[m_idx] = UNIT_MOTHERSHIP;
+            s->world.units.stats[m_idx] = &s->world.unit_stats[UNIT_MOTHERSHIP];
         }
     }
 
@@ -277,20 +293,23 @@ static void HandleRespawn(AppState *s, float dt, int win_w, int win_h) {
         s->world.units.health[i] = s->world.units.stats[i]->max_health;
         s->world.units.energy[i] = s->world.units.stats[i]->max_energy;
         s->world.units.velocity[i] = (Vec2){0, 0};
-        s->world.units.command_count[i] = 0;
-        s->world.units.command_current_idx[i] = 0;
-        s->world.units.has_target[i] = false;
-        s->world.units.production_timer[i] = 0.0f;
-        s->world.units.production_count[i] = 0;
+        s->world.orders.count[i] = 0;
+        s->world.orders.current_idx[i] = 0;
+        s->world.orders.has_target[i] = false;
+        s->world.production.timer[i] = 0.0f;
+        s->world.production.count[i] = 0;
 
         int attempts = 0;
         Vec2 spawn_p = s->ui.respawn_pos;
         while (attempts < RESPAWN_ATTEMPTS) {
-          float rx = s->ui.respawn_pos.x + (float)(rand() % (int)(RESPAWN_RANGE * 2) - RESPAWN_RANGE),
-                ry = s->ui.respawn_pos.y + (float)(rand() % (int)(RESPAWN_RANGE * 2) - RESPAWN_RANGE);
+          float rx = s->ui.respawn_pos.x + (float)(Rng_Int(&s->world.rng_sim, (int)(RESPAWN_RANGE * 2)) - RESPAWN_RANGE),
+                ry = s->ui.respawn_pos.y + (float)(Rng_Int(&s->world.rng_sim, (int)(RESPAWN_RANGE * 2)) - RESPAWN_RANGE);
           bool safe = true;
-          for (int j = 0; j < MAX_ASTEROIDS; j++) {
-            if (!s->world.asteroids.active[j]) continue;
+          // Grid is from the previous tick; the query margin covers the drift since
+          int ids[SPATIAL_MAX_IDS];
+          int n = Spatial_QueryRadius(s, &s->world.grid, (Vec2){rx, ry}, s->world.grid.max_radius[SPATIAL_ASTEROID] + s->world.units.stats[i]->radius + RESPAWN_BUFFER, SPATIAL_MASK(SPATIAL_ASTEROID), ids, SPATIAL_MAX_IDS);
+          for (int k = 0; k < n; k++) {
+            int j = ids[k];
             if (Vector_DistanceSq((Vec2){rx, ry}, s->world.asteroids.pos[j]) < 
                 powf(s->world.asteroids.radius[j] + s->world.units.stats[i]->radius + RESPAWN_BUFFER, 2)) {
               safe = false; break;
@@ -300,12 +319,13 @@ static void HandleRespawn(AppState *s, float dt, int win_w, int win_h) {
           attempts++;
         }
         s->world.units.pos[i] = spawn_p;
+        s->world.units.prev_pos[i] = spawn_p;
         Particles_SpawnTeleport(s, spawn_p, s->world.units.stats[i]->radius * 2.5f);
         UI_SetError(s, "MOTHERSHIP ONLINE");
         
         // Select it
-        SDL_memset(s->selection.unit_selected, 0, sizeof(s->selection.unit_selected));
-        s->selection.unit_selected[i] = true;
+        Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
+        Bits_Set(s->selection.unit_selected, i);
         s->selection.primary_unit_idx = i;
     }
   }
@@ -317,43 +337,43 @@ static void UpdateSpawning(AppState *s, Vec2 cam_center) {
   if (total_target_count > 200)
     total_target_count = 200;
 
-  for (int i = 0; i < MAX_ASTEROIDS; i++) {
-    if (!s->world.asteroids.active[i])
+  // Backwards, as despawning swaps the last live slot into the freed one's place
+  for (int k = s->world.slots.asteroids.live_count - 1; k >= 0; k--) {
+    int i = s->world.slots.asteroids.live[k];
+    // Measured where the banked time would put it, so sleepers still drift out of range and despawn
+    Vec2 p = Vector_Add(s->world.asteroids.pos[i], Vector_Scale(s->world.asteroids.velocity[i], s->world.asteroids.drift_dt[i]));
+    float nearest_sq = FLT_MAX;
+    for (int a = 0; a < s->world.sim_anchor_count; a++)
+      nearest_sq = fminf(nearest_sq, Vector_DistanceSq(p, s->world.sim_anchors[a].pos));
+    if (nearest_sq >= DESPAWN_RANGE * DESPAWN_RANGE) {
+      Slots_FreeAsteroid(s, i);
       continue;
-    s->world.asteroids.targeted[i] = false;
-    bool in_range = false;
-    for (int a = 0; a < s->world.sim_anchor_count; a++) {
-      if (Vector_DistanceSq(s->world.asteroids.pos[i],
-                            s->world.sim_anchors[a].pos) <
-          DESPAWN_RANGE * DESPAWN_RANGE) {
-        in_range = true;
-        break;
-      }
-    }
-    if (!in_range) {
-      s->world.asteroids.active[i] = false;
-      s->world.asteroid_count--;
     }
+    // Re-tiered every tick, so a sleeper wakes as soon as an anchor approaches
+    s->world.asteroids.tier[i] = nearest_sq < SIM_FULL_RANGE * SIM_FULL_RANGE ? SIM_TIER_FULL
+                                 : nearest_sq < SIM_DRIFT_RANGE * SIM_DRIFT_RANGE ? SIM_TIER_DRIFT
+                                                                                 : SIM_TIER_SLEEP;
   }
 
-  for (int i = 0; i < MAX_RESOURCES; i++) {
-      if (!s->world.resources.active[i]) continue;
+  for (int k = s->world.slots.resources.live_count - 1; k >= 0; k--) {
+      int i = s->world.slots.resources.live[k];
       bool in_range = false;
       for (int a = 0; a < s->world.sim_anchor_count; a++) {
           if (Vector_DistanceSq(s->world.resources.pos[i], s->world.sim_anchors[a].pos) < DESPAWN_RANGE * DESPAWN_RANGE) { in_range = true; break; }
       }
-      if (!in_range) { s->world.resources.active[i] = false; s->world.resource_count--; }
+      if (!in_range) Slots_FreeResource(s, i);
   }
 
   int attempts = 0;
   while (s->world.asteroid_count < total_target_count &&
          attempts < ASTEROID_SPAWN_ATTEMPTS) {
     attempts++;
+    s->counters.spawn_attempts++;
     Vec2 target_center =
-        s->world.sim_anchors[rand() % s->world.sim_anchor_count].pos;
-    float angle = (float)(rand() % 360) * 0.0174533f;
+        s->world.sim_anchors[Rng_Int(&s->world.rng_sim, s->world.sim_anchor_count)].pos;
+    float angle = (float)Rng_Int(&s->world.rng_sim, 360) * 0.0174533f;
     float dist = SPAWN_MIN_DIST +
-                 (float)(rand() % (int)(DESPAWN_RANGE * 0.8f - SPAWN_MIN_DIST));
+                 (float)(Rng_Int(&s->world.rng_sim, (int)(DESPAWN_RANGE * 0.8f - SPAWN_MIN_DIST)));
     Vec2 spawn_pos = {target_center.x + cosf(angle) * dist,
                       target_center.y + sinf(angle) * dist};
 
@@ -365,15 +385,15 @@ static void UpdateSpawning(AppState *s, Vec2 cam_center) {
             break;
         }
     }
-    if (unsafe) continue;
+    if (unsafe) { s->counters.spawn_rejections++; continue; }
 
-    if (((float)rand() / (float)RAND_MAX) < GetAsteroidDensity(spawn_pos)) {
+    if (Rng_Float(&s->world.rng_sim) < GetAsteroidDensity(spawn_pos)) {
       float new_rad = ASTEROID_BASE_RADIUS_MIN +
-                      (rand() % (int)ASTEROID_BASE_RADIUS_VARIANCE);
+                      Rng_Int(&s->world.rng_sim, (int)ASTEROID_BASE_RADIUS_VARIANCE);
       bool overlap = false;
-      for (int j = 0; j < MAX_ASTEROIDS; j++) {
-        if (s->world.asteroids.active[j] &&
-            Vector_DistanceSq(s->world.asteroids.pos[j], spawn_pos) <
+      for (int k = 0; k < s->world.slots.asteroids.live_count; k++) {
+        int j = s->world.slots.asteroids.live[k];
+        if (Vector_DistanceSq(s->world.asteroids.pos[j], spawn_pos) <
                 powf((s->world.asteroids.radius[j] + new_rad) *
                              ASTEROID_HITBOX_MULT +
                          SPAWN_BUFFER,
@@ -383,18 +403,20 @@ static void UpdateSpawning(AppState *s, Vec2 cam_center) {
         }
       }
       if (!overlap) {
-        float move_angle = (float)(rand() % 360) * 0.0174533f;
+        float move_angle = (float)Rng_Int(&s->world.rng_sim, 360) * 0.0174533f;
         SpawnAsteroid(s, spawn_pos, (Vec2){cosf(move_angle), sinf(move_angle)}, new_rad);
-      }
-    }
+      } else s->counters.spawn_rejections++;
+    } else s->counters.spawn_rejections++;
   }
 
   // --- INDEPENDENT CRYSTAL SPAWNING PASS ---
   if (s->world.resource_count < MAX_RESOURCES) {
       for (int c = 0; c < CRYSTAL_SPAWN_ATTEMPTS; c++) {
-        Vec2 target_center = s->world.sim_anchors[rand() % s->world.sim_anchor_count].pos;
-        float angle = (float)(rand() % 360) * 0.0174533f;
-        float dist = SPAWN_MIN_DIST + (float)(rand() % (int)(DESPAWN_RANGE * 0.8f - SPAWN_MIN_DIST));
+        s->counters.spawn_attempts++;
+        bool spawned = false;
+        Vec2 target_center = s->world.sim_anchors[Rng_Int(&s->world.rng_sim, s->world.sim_anchor_count)].pos;
+        float angle = (float)Rng_Int(&s->world.rng_sim, 360) * 0.0174533f;
+        float dist = SPAWN_MIN_DIST + (float)(Rng_Int(&s->world.rng_sim, (int)(DESPAWN_RANGE * 0.8f - SPAWN_MIN_DIST)));
         Vec2 spawn_pos = {target_center.x + cosf(angle) * dist, target_center.y + sinf(angle) * dist};
 
         // Safe zone check
@@ -404,7 +426,7 @@ static void UpdateSpawning(AppState *s, Vec2 cam_center) {
                 unsafe = true; break;
             }
         }
-        if (unsafe) continue;
+        if (unsafe) { s->counters.spawn_rejections++; continue; }
 
         int gx_center = (int)floorf(spawn_pos.x / CELESTIAL_GRID_SIZE_F);
         int gy_center = (int)floorf(spawn_pos.y / CELESTIAL_GRID_SIZE_F);
@@ -415,17 +437,17 @@ static void UpdateSpawning(AppState *s, Vec2 cam_center) {
             // Modulate probability by density strength
             crystal_prob *= (density / DENSITY_MAX);
 
-            if (((float)rand() / (float)RAND_MAX) < crystal_prob) {
-                float c_rad = CRYSTAL_RADIUS_LARGE_MIN + ((float)rand() / (float)RAND_MAX) * CRYSTAL_RADIUS_LARGE_VARIANCE;
-                float move_angle = (float)(rand() % 360) * 0.0174533f;
+            if (Rng_Float(&s->world.rng_sim) < crystal_prob) {
+                float c_rad = CRYSTAL_RADIUS_LARGE_MIN + Rng_Float(&s->world.rng_sim) * CRYSTAL_RADIUS_LARGE_VARIANCE;
+                float move_angle = (float)Rng_Int(&s->world.rng_sim, 360) * 0.0174533f;
                 
                 // Find a celestial body to anchor the cluster visually
                 for (int dy = -1; dy <= 1; dy++) {
                     for (int dx = -1; dx <= 1; dx++) {
                         Vec2 b_pos; float type_seed, b_rad;
                         if (GetCelestialBodyInfo(gx_center + dx, gy_center + dy, &b_pos, &type_seed, &b_rad)) {
-                            float spread_dist = b_rad + 800.0f + ((float)rand() / (float)RAND_MAX) * 3000.0f;
-                            float spread_angle = (float)(rand() % 360) * 0.0174533f;
+                            float spread_dist = b_rad + 800.0f + Rng_Float(&s->world.rng_sim) * 3000.0f;
+                            float spread_angle = (float)Rng_Int(&s->world.rng_sim, 360) * 0.0174533f;
                             Vec2 crystal_pos = {
                                 b_pos.x + cosf(spread_angle) * spread_dist,
                                 b_pos.y + sinf(spread_angle) * spread_dist
@@ -433,6 +455,7 @@ static void UpdateSpawning(AppState *s, Vec2 cam_center) {
                             
                             if (Vector_DistanceSq(crystal_pos, cam_center) > (1280.0f/s->camera.zoom) * (1280.0f/s->camera.zoom)) {
                                 SpawnCrystal(s, crystal_pos, (Vec2){cosf(move_angle), sinf(move_angle)}, c_rad);
+                                spawned = true;
                             }
                             goto next_crystal_attempt;
                         }
@@ -440,7 +463,8 @@ static void UpdateSpawning(AppState *s, Vec2 cam_center) {
                 }
             }
         }
-        next_crystal_attempt:;
+        next_crystal_attempt:
+        if (!spawned) s->counters.spawn_rejections++;
       }
   }
 }
@@ -449,7 +473,7 @@ static void UpdateRadar(AppState *s) {
   Vec2 m_pos = {0, 0};
   bool found = false;
   for (int i = 0; i < MAX_UNITS; i++)
-    if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) {
+    if (Bits_Test(s->world.units.active, i) && s->world.units.type[i] == UNIT_MOTHERSHIP) {
       m_pos = s->world.units.pos[i];
       found = true;
       break;
@@ -465,9 +489,14 @@ static void UpdateRadar(AppState *s) {
 void Game_Update(AppState *s, float dt) {
   if (s->game_state == STATE_PAUSED)
     return;
-  int win_w, win_h;
-  SDL_GetRenderOutputSize(s->renderer, &win_w, &win_h);
-
+  int win_w = s->camera.view_w, win_h = s->camera.view_h;
+  Profiler_Begin(s, PROF_UPDATE);
+  Game_SnapshotState(s);
+  Counters_BeginTick(s);
+  s->world.collision_events.count = 0;
+  s->world.collision_events.dropped = 0;
+
+  Profiler_Begin(s, PROF_UPDATE_MISC);
   HandleRespawn(s, dt, win_w, win_h);
   if (s->ui.hold_flash_timer > 0)
     s->ui.hold_flash_timer -= dt;
@@ -503,8 +532,8 @@ void Game_Update(AppState *s, float dt) {
 
   // Apply Camera Shake
   if (s->camera.shake_intensity > 0.1f) {
-      s->camera.pos.x += ((float)rand()/(float)RAND_MAX - 0.5f) * s->camera.shake_intensity;
-      s->camera.pos.y += ((float)rand()/(float)RAND_MAX - 0.5f) * s->camera.shake_intensity;
+      s->camera.pos.x += (Rng_Float(&s->world.rng_sim) - 0.5f) * s->camera.shake_intensity;
+      s->camera.pos.y += (Rng_Float(&s->world.rng_sim) - 0.5f) * s->camera.shake_intensity;
       s->camera.shake_intensity *= expf(-5.0f * dt); // Quick decay
   } else {
       s->camera.shake_intensity = 0;
@@ -514,7 +543,7 @@ void Game_Update(AppState *s, float dt) {
   // Update Energy
   s->world.energy = fminf(INITIAL_ENERGY, s->world.energy + ENERGY_REGEN_RATE * dt);
   for (int i = 0; i < MAX_UNITS; i++) {
-      if (s->world.units.active[i] && s->world.units.type[i] != UNIT_MOTHERSHIP) {
+      if (Bits_Test(s->world.units.active, i) && s->world.units.type[i] != UNIT_MOTHERSHIP) {
           float regen = s->world.units.stats[i]->max_energy * s->world.units.stats[i]->regen_rate;
           s->world.units.energy[i] = fminf(s->world.units.stats[i]->max_energy, s->world.units.energy[i] + regen * dt);
       }
@@ -522,19 +551,21 @@ void Game_Update(AppState *s, float dt) {
 
   // Camera Management (Simulated Anchors)
 
-  for (int i = 0; i < MAX_ASTEROIDS; i++) s->world.asteroids.targeted[i] = false;
+  Bits_ClearAll(s->world.asteroids.targeted, MAX_ASTEROIDS);
 
   UpdateRadar(s);
+  Profiler_End(s, PROF_UPDATE_MISC);
 
   // Update Production Logic (Continuous Toggle)
+  Profiler_Begin(s, PROF_PRODUCTION);
   for (int i = 0; i < MAX_UNITS; i++) {
-      if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MOTHERSHIP && s->world.units.production_mode[i] != UNIT_TYPE_COUNT) {
-          UnitType target_type = s->world.units.production_mode[i];
+      if (Bits_Test(s->world.units.active, i) && s->world.units.type[i] == UNIT_MOTHERSHIP && s->world.production.mode[i] != UNIT_TYPE_COUNT) {
+          UnitType target_type = s->world.production.mode[i];
           float cost = s->world.unit_stats[target_type].production_cost;
           float build_time = s->world.unit_stats[target_type].production_time;
 
           // Check for resources and unit cap at start of cycle or while waiting
-          if (s->world.units.production_timer[i] == 0.0f) {
+          if (s->world.production.timer[i] == 0.0f) {
               if (s->world.stored_resources < cost) {
                   // Wait for resources, don't advance timer
                   continue;
@@ -548,107 +579,121 @@ void Game_Update(AppState *s, float dt) {
               LogTransaction(s, -cost, target_type == UNIT_MINER ? "Miner Production" : "Fighter Production");
           }
 
-          s->world.units.production_timer[i] += dt;
+          s->world.production.timer[i] += dt;
           
-          if (s->world.units.production_timer[i] >= build_time) {
+          if (s->world.production.timer[i] >= build_time) {
               // Spawn Unit
-              int new_idx = -1;
-              for (int u = 0; u < MAX_UNITS; u++) { if (!s->world.units.active[u]) { new_idx = u; break; } }
+              int new_idx = Slots_AllocUnit(s);
               
               if (new_idx != -1) {
-                  float spawn_angle = (float)(rand() % 360) * 0.0174533f;
-                  float spawn_dist = s->world.units.stats[i]->radius + 150.0f + ((float)rand()/(float)RAND_MAX) * 200.0f;
+                  float spawn_angle = (float)Rng_Int(&s->world.rng_sim, 360) * 0.0174533f;
+                  float spawn_dist = s->world.units.stats[i]->radius + 150.0f + Rng_Float(&s->world.rng_sim) * 200.0f;
                   Vec2 spawn_pos = {
                       s->world.units.pos[i].x + cosf(spawn_angle) * spawn_dist,
                       s->world.units.pos[i].y + sinf(spawn_angle) * spawn_dist
                   };
 
-                  s->world.units.active[new_idx] = true;
                   s->world.units.type[new_idx] = target_type;
                   s->world.units.stats[new_idx] = &s->world.unit_stats[target_type];
                   s->world.units.pos[new_idx] = spawn_pos;
+                  s->world.units.prev_pos[new_idx] = spawn_pos;
                   s->world.units.velocity[new_idx] = (Vec2){0,0};
                   s->world.units.rotation[new_idx] = s->world.units.rotation[i];
+                  s->world.units.prev_rotation[new_idx] = s->world.units.rotation[i];
                   s->world.units.health[new_idx] = s->world.units.stats[new_idx]->max_health;
                   s->world.units.energy[new_idx] = s->world.units.stats[new_idx]->max_energy;
                   s->world.units.current_cargo[new_idx] = 0.0f;
-                  s->world.units.behavior[new_idx] = BEHAVIOR_DEFENSIVE;
-                  s->world.units.command_count[new_idx] = 0;
-                  s->world.units.command_current_idx[new_idx] = 0;
-                  s->world.units.has_target[new_idx] = false;
-                  s->world.units.large_target_idx[new_idx] = -1;
+                  s->world.orders.behavior[new_idx] = BEHAVIOR_DEFENSIVE;
+                  s->world.orders.count[new_idx] = 0;
+                  s->world.orders.current_idx[new_idx] = 0;
+                  s->world.orders.has_target[new_idx] = false;
+                  s->world.targets.large[new_idx] = -1;
                   s->world.units.mining_cooldown[new_idx] = 0.0f;
-                  s->world.units.production_mode[new_idx] = UNIT_TYPE_COUNT;
-                  for(int c=0; c<4; c++) s->world.units.small_target_idx[new_idx][c] = -1;
-                  s->world.unit_count++;
+                  s->world.production.mode[new_idx] = UNIT_TYPE_COUNT;
+                  for(int c=0; c<4; c++) s->world.targets.small[new_idx][c] = -1;
                   
                   Particles_SpawnTeleport(s, spawn_pos, s->world.units.stats[new_idx]->radius * 2.0f);
                   
-                  s->world.units.production_timer[i] = 0.0f; // Reset for next loop and continue producing the same type
+                  s->world.production.timer[i] = 0.0f; // Reset for next loop and continue producing the same type
                   UI_SetError(s, "UNIT READY");
               }
           }
       } else {
-          s->world.units.production_timer[i] = 0.0f;
+          s->world.production.timer[i] = 0.0f;
       }
   }
 
-  // Update Mouse Over Asteroid
+  Profiler_End(s, PROF_PRODUCTION);
+
+  Profiler_Begin(s, PROF_SPAWNING);
+  UpdateSpawning(s, cam_center);
+  Profiler_End(s, PROF_SPAWNING);
+
+  Profiler_Begin(s, PROF_INTEGRATE);
+  Physics_UpdateAsteroids(s, dt);
+  Physics_UpdateResources(s, dt);
+  Profiler_End(s, PROF_INTEGRATE);
+  Profiler_Begin(s, PROF_COLLISIONS);
+  Spatial_Build(s, &s->world.grid);
+  Physics_HandleCollisions(s, dt);
+  Profiler_End(s, PROF_COLLISIONS);
+
+  // Update Mouse Over Asteroid (after the rebuild so picking sees this tick's grid)
+  Profiler_Begin(s, PROF_HOVER);
   float wx = s->camera.pos.x + s->input.mouse_pos.x / s->camera.zoom;
   float wy = s->camera.pos.y + s->input.mouse_pos.y / s->camera.zoom;
-  s->input.hover_asteroid_idx = -1;
-  for (int a = 0; a < MAX_ASTEROIDS; a++) {
-    if (!s->world.asteroids.active[a])
-      continue;
+  s->input.hover_asteroid = -1;
+  int ids[SPATIAL_MAX_IDS];
+  int n = Spatial_QueryRadius(s, &s->world.grid, (Vec2){wx, wy}, s->world.grid.max_radius[SPATIAL_ASTEROID] * ASTEROID_HITBOX_MULT, SPATIAL_MASK(SPATIAL_ASTEROID), ids, SPATIAL_MAX_IDS);
+  for (int k = 0; k < n; k++) {
+    int a = ids[k];
     float dx = s->world.asteroids.pos[a].x - wx,
           dy = s->world.asteroids.pos[a].y - wy;
     float r = s->world.asteroids.radius[a] * ASTEROID_HITBOX_MULT;
     if (dx * dx + dy * dy < r * r) {
-      s->input.hover_asteroid_idx = a;
+      s->input.hover_asteroid = Slots_AsteroidHandle(s, a);
       break;
     }
   }
 
   // Update Mouse Over Resource
-  s->input.hover_resource_idx = -1;
-  for (int i = 0; i < MAX_RESOURCES; i++) {
-      if (!s->world.resources.active[i]) continue;
+  s->input.hover_resource = -1;
+  n = Spatial_QueryRadius(s, &s->world.grid, (Vec2){wx, wy}, s->world.grid.max_radius[SPATIAL_RESOURCE] * CRYSTAL_VISUAL_SCALE * 0.5f, SPATIAL_MASK(SPATIAL_RESOURCE), ids, SPATIAL_MAX_IDS);
+  for (int k = 0; k < n; k++) {
+      int i = Spatial_Index(ids[k]);
       float dx = s->world.resources.pos[i].x - wx, dy = s->world.resources.pos[i].y - wy;
       // Crystals are visually larger than their physics radius might imply, especially with glow.
       // Using visual scale for hit detection feels better for UI interaction.
       float r = s->world.resources.radius[i] * CRYSTAL_VISUAL_SCALE * 0.5f; 
       if (dx*dx + dy*dy < r*r) {
-          s->input.hover_resource_idx = i;
+          s->input.hover_resource = Slots_ResourceHandle(s, i);
           break;
       }
   }
 
-  UpdateSpawning(s, cam_center);
+  Profiler_End(s, PROF_HOVER);
 
-  Physics_UpdateAsteroids(s, dt);
-  Physics_UpdateResources(s, dt);
-  Physics_HandleCollisions(s, dt);
-
-  for (int i = 0; i < MAX_UNITS; i++) {
-    if (!s->world.units.active[i])
-      continue;
-    
+  Profiler_Begin(s, PROF_UNITS);
+  BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) {
+    Profiler_Begin(s, PROF_UNIT_MOVEMENT);
     AI_UpdateUnitMovement(s, i, dt);
+    Profiler_End(s, PROF_UNIT_MOVEMENT);
 
+    Profiler_Begin(s, PROF_ABILITIES);
     Abilities_Update(s, i, dt);
+    Profiler_End(s, PROF_ABILITIES);
 
     // Unit Destruction Logic
     if (s->world.units.health[i] <= 0) {
-        s->world.units.active[i] = false;
-        s->world.unit_count--;
+        Slots_FreeUnit(s, i);
         
         // Remove from selection and groups
-        s->selection.unit_selected[i] = false;
-        for (int g = 0; g < 10; g++) s->selection.group_members[g][i] = false;
+        Bits_Clear(s->selection.unit_selected, i);
+        for (int g = 0; g < 10; g++) Bits_Clear(s->selection.group_members[g], i);
         if (s->selection.primary_unit_idx == i) s->selection.primary_unit_idx = -1;
 
         Particles_SpawnExplosion(s, s->world.units.pos[i], 120, s->world.units.stats[i]->visual_scale * 3.0f, EXPLOSION_COLLISION, 0);
-        Physics_AreaDamage(s, s->world.units.pos[i], s->world.units.stats[i]->radius * 5.0f, s->world.units.stats[i]->max_health * 0.5f, i);
+        Commands_AreaDamage(s, s->world.units.pos[i], s->world.units.stats[i]->radius * 5.0f, s->world.units.stats[i]->max_health * 0.5f, i);
         
         if (s->world.units.type[i] == UNIT_MOTHERSHIP) {
             UI_SetError(s, "MOTHERSHIP DESTROYED! RESPAWNING...");
@@ -661,6 +706,19 @@ void Game_Update(AppState *s, float dt) {
         }
     }
   }
+  // Blasts from deaths and crystal splits land after every unit has moved
+  Commands_Flush(s);
 
+  Profiler_End(s, PROF_UNITS);
+
+  Profiler_Begin(s, PROF_PARTICLES);
+  Particles_SpawnCollisionVfx(s);
   Particles_Update(s, dt);
+  Profiler_End(s, PROF_PARTICLES);
+
+  s->world.state_hash = StateHash_World(s);
+#if SLOTS_VALIDATE
+  Slots_Validate(s);
+#endif
+  Profiler_End(s, PROF_UPDATE);
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#include "headless.h"
+#include "ai.h"
+#include "constants.h"
+#include "game.h"
+#include "profiler.h"
+#include "slots.h"
+#include "trace.h"
+
+void Headless_Init(AppState *s, unsigned int seed, int view_w, int view_h) {
+  Game_Seed(s, seed);
+  s->camera.view_w = view_w;
+  s->camera.view_h = view_h;
+  s->camera.zoom = 1.0f;
+  s->input.show_grid = false;
+  s->selection.primary_unit_idx = -1;
+  s->sim_dt = 1.0f / (float)SIM_TICK_RATE;
+  s->render_alpha = 1.0f;
+  Trace_Init(s);
+
+  Game_Init(s);
+
+  // Park the cursor in the middle so edge scrolling never kicks in
+  s->input.mouse_pos = (Vec2){view_w / 2.0f, view_h / 2.0f};
+  s->input.hover_asteroid = -1;
+  s->input.hover_resource = -1;
+  s->game_state = STATE_GAME;
+}
+
+void Headless_Step(AppState *s, float dt) {
+  Profiler_BeginFrame(s);
+  // Targeting normally runs on its own thread; run it inline so ticks are reproducible
+  Profiler_Begin(s, PROF_TARGETING);
+  AI_UpdateTargeting(s);
+  Profiler_End(s, PROF_TARGETING);
+  Game_Update(s, dt);
+  s->current_time += dt;
+  Profiler_EndFrame(s);
+}
+
+// Drops a ready-built unit into the first free slot, returns -1 when the pool is full
+int Headless_SpawnUnit(AppState *s, UnitType type, Vec2 pos, TacticalBehavior behavior) {
+  int idx = Slots_AllocUnit(s);
+  if (idx == -1) return -1;
+
+  s->world.units.type[idx] = type;
+  s->world.units.stats[idx] = &s->world.unit_stats[type];
+  s->world.units.pos[idx] = pos;
+  s->world.units.prev_pos[idx] = pos;
+  s->world.units.velocity[idx] = (Vec2){0, 0};
+  s->world.units.rotation[idx] = 0.0f;
+  s->world.units.prev_rotation[idx] = 0.0f;
+  s->world.units.health[idx] = s->world.units.stats[idx]->max_health;
+  s->world.units.energy[idx] = s->world.units.stats[idx]->max_energy;
+  s->world.units.current_cargo[idx] = 0.0f;
+  s->world.orders.behavior[idx] = behavior;
+  s->world.orders.count[idx] = 0;
+  s->world.orders.current_idx[idx] = 0;
+  s->world.orders.has_target[idx] = false;
+  s->world.targets.large[idx] = -1;
+  s->world.units.mining_cooldown[idx] = 0.0f;
+  s->world.production.mode[idx] = UNIT_TYPE_COUNT;
+  for (int c = 0; c < 4; c++) s->world.targets.small[idx][c] = -1;
+  return idx;
+}
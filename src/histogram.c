@@ -0,0 +1,41 @@
+#include "histogram.h"
+
+// First HISTOGRAM_SUB_BUCKETS microseconds are exact, after that each power of two gets the same number of steps
+static int BucketFor(Uint32 us) {
+  if (us < HISTOGRAM_SUB_BUCKETS) return (int)us;
+  int exp = SDL_MostSignificantBitIndex32(us); // >= 4
+  int sub = (int)(us >> (exp - 4)) & (HISTOGRAM_SUB_BUCKETS - 1);
+  int bucket = HISTOGRAM_SUB_BUCKETS + (exp - 4) * HISTOGRAM_SUB_BUCKETS + sub;
+  return bucket < HISTOGRAM_BUCKETS ? bucket : HISTOGRAM_BUCKETS - 1;
+}
+
+// Midpoint of the bucket, in microseconds
+static double BucketValue(int bucket) {
+  if (bucket < HISTOGRAM_SUB_BUCKETS) return (double)bucket;
+  int exp = (bucket - HISTOGRAM_SUB_BUCKETS) / HISTOGRAM_SUB_BUCKETS + 4;
+  int sub = (bucket - HISTOGRAM_SUB_BUCKETS) % HISTOGRAM_SUB_BUCKETS;
+  double width = (double)(1ull << (exp - 4));
+  return (double)(HISTOGRAM_SUB_BUCKETS + sub) * width + width * 0.5;
+}
+
+void Histogram_Record(Histogram *h, double ms) {
+  int bucket = BucketFor(ms <= 0.0 ? 0 : ms >= 4.0e6 ? 0xFFFFFFFFu : (Uint32)(ms * 1000.0));
+  if (h->count == HISTOGRAM_WINDOW) h->counts[h->samples[h->head]]--;
+  else h->count++;
+  h->samples[h->head] = (Uint16)bucket;
+  h->counts[bucket]++;
+  h->head = (h->head + 1) % HISTOGRAM_WINDOW;
+}
+
+// p in [0, 1], result in ms; 0 when the window is empty
+double Histogram_Percentile(const Histogram *h, double p) {
+  if (h->count == 0) return 0.0;
+  int target = (int)(p * h->count + 0.999999);
+  if (target < 1) target = 1;
+  int seen = 0;
+  for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+    seen += h->counts[b];
+    if (seen >= target) return BucketValue(b) / 1000.0;
+  }
+  return BucketValue(HISTOGRAM_BUCKETS - 1) / 1000.0;
+}
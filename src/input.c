@@ -3,25 +3,27 @@
 #include "game.h"
 #include "ui.h"
 #include "persistence.h"
+#include "trace.h"
 #include "utils.h"
+#include "spatial.h"
+#include "slots.h"
 #include <math.h>
 #include <stdio.h>
 
 void Input_ScheduleCommand(AppState *s, Command cmd, bool queue) {
-    for (int i = 0; i < MAX_UNITS; i++) {
-        if (!s->world.units.active[i] || !s->selection.unit_selected[i]) continue;
+    BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) {
 
         // Command Filtering
         if (s->world.units.type[i] == UNIT_FIGHTER && cmd.type == CMD_GATHER) continue;
-        if (s->world.units.type[i] == UNIT_MINER && cmd.type == CMD_ATTACK_MOVE && cmd.target_idx != -1) continue;
+        if (s->world.units.type[i] == UNIT_MINER && cmd.type == CMD_ATTACK_MOVE && cmd.target != -1) continue;
 
         if (cmd.type == CMD_MAIN_CANNON) {
-            if (s->world.units.large_cannon_cooldown[i] > 0) {
+            if (s->world.targets.large_cooldown[i] > 0) {
                 UI_SetError(s, "MAIN CANNON COOLDOWN");
                 continue;
             }
-            if (s->world.units.type[i] == UNIT_MOTHERSHIP && cmd.target_idx != -1) {
-                s->world.units.large_target_idx[i] = cmd.target_idx;
+            if (s->world.units.type[i] == UNIT_MOTHERSHIP && cmd.target != -1) {
+                s->world.targets.large[i] = cmd.target;
             }
             continue;
         }
@@ -34,15 +36,15 @@ void Input_ScheduleCommand(AppState *s, Command cmd, bool queue) {
         }
 
         if (queue) {
-            if (s->world.units.command_count[i] < MAX_COMMANDS) {
-                s->world.units.command_queue[i][s->world.units.command_count[i]++] = cmd;
-                s->world.units.has_target[i] = true;
+            if (s->world.orders.count[i] < MAX_COMMANDS) {
+                s->world.orders.queue[i][s->world.orders.count[i]++] = cmd;
+                s->world.orders.has_target[i] = true;
             }
         } else {
-            s->world.units.command_queue[i][0] = cmd;
-            s->world.units.command_count[i] = 1;
-            s->world.units.command_current_idx[i] = 0;
-            s->world.units.has_target[i] = true;
+            s->world.orders.queue[i][0] = cmd;
+            s->world.orders.count[i] = 1;
+            s->world.orders.current_idx[i] = 0;
+            s->world.orders.has_target[i] = true;
         }
     }
 }
@@ -61,6 +63,7 @@ void Input_HandleMouseWheel(AppState *s, SDL_MouseWheelEvent *event) {
     
     s->camera.pos.x = center_world_x - (win_w / 2.0f) / s->camera.zoom;
     s->camera.pos.y = center_world_y - (win_h / 2.0f) / s->camera.zoom;
+    s->camera.prev_pos = s->camera.pos; // Zoom snaps, don't blend it
 }
 
 void Input_HandleMouseMove(AppState *s, SDL_MouseMotionEvent *event) {
@@ -84,6 +87,7 @@ static void HandleLeftClick(AppState *s, SDL_MouseButtonEvent *event, int win_w,
         float rel_y = (event->y - mm_y) / MINIMAP_SIZE - 0.5f;
         s->camera.pos.x += rel_x * MINIMAP_RANGE;
         s->camera.pos.y += rel_y * MINIMAP_RANGE;
+        s->camera.prev_pos = s->camera.pos; // Jumps snap, don't blend them
         return;
     }
 
@@ -99,29 +103,29 @@ static void HandleLeftClick(AppState *s, SDL_MouseButtonEvent *event, int win_w,
             else if (btn_idx == 1) s->input.pending_cmd_type = CMD_MOVE;
             else if (btn_idx == 2) s->input.pending_cmd_type = CMD_ATTACK_MOVE;
             else if (btn_idx == 3) { // Stop
-                for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) { 
-                    s->world.units.velocity[i] = (Vec2){0,0}; s->world.units.has_target[i] = false; 
-                    s->world.units.command_count[i] = 0; s->world.units.command_current_idx[i] = 0; 
+                BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) { 
+                    s->world.units.velocity[i] = (Vec2){0,0}; s->world.orders.has_target[i] = false; 
+                    s->world.orders.count[i] = 0; s->world.orders.current_idx[i] = 0; 
                 }
                 s->ui.hold_flash_timer = 0.2f;
             }
-            else if (btn_idx == 5) { for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) s->world.units.behavior[i] = BEHAVIOR_OFFENSIVE; s->ui.tactical_flash_timer = 0.2f; }
-            else if (btn_idx == 6) { for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) s->world.units.behavior[i] = BEHAVIOR_DEFENSIVE; s->ui.tactical_flash_timer = 0.2f; }
-            else if (btn_idx == 7) { for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) s->world.units.behavior[i] = BEHAVIOR_HOLD_GROUND; s->ui.tactical_flash_timer = 0.2f; }
+            else if (btn_idx == 5) { BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) s->world.orders.behavior[i] = BEHAVIOR_OFFENSIVE; s->ui.tactical_flash_timer = 0.2f; }
+            else if (btn_idx == 6) { BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) s->world.orders.behavior[i] = BEHAVIOR_DEFENSIVE; s->ui.tactical_flash_timer = 0.2f; }
+            else if (btn_idx == 7) { BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) s->world.orders.behavior[i] = BEHAVIOR_HOLD_GROUND; s->ui.tactical_flash_timer = 0.2f; }
             else if (btn_idx == 10) s->input.pending_cmd_type = CMD_MAIN_CANNON;
             else if (btn_idx == 11) s->ui.menu_state = 1; // Build
             else if (btn_idx == 12) { // Return Cargo
                  for (int i = 0; i < MAX_UNITS; i++) {
-                    if (s->world.units.active[i] && s->selection.unit_selected[i] && s->world.units.type[i] == UNIT_MINER) {
+                    if (Bits_Test(s->world.units.active, i) && Bits_Test(s->selection.unit_selected, i) && s->world.units.type[i] == UNIT_MINER) {
                         int m_idx = -1; float min_d = 1e18;
                         for (int j = 0; j < MAX_UNITS; j++) {
-                            if (s->world.units.active[j] && s->world.units.type[j] == UNIT_MOTHERSHIP) {
+                            if (Bits_Test(s->world.units.active, j) && s->world.units.type[j] == UNIT_MOTHERSHIP) {
                                 float d = Vector_DistanceSq(s->world.units.pos[i], s->world.units.pos[j]);
                                 if (d < min_d) { min_d = d; m_idx = j; }
                             }
                         }
                         if (m_idx != -1) {
-                            Command cmd = { .pos = s->world.units.pos[m_idx], .target_idx = m_idx, .type = CMD_RETURN_CARGO };
+                            Command cmd = { .pos = s->world.units.pos[m_idx], .target = -1, .type = CMD_RETURN_CARGO };
                             Input_ScheduleCommand(s, cmd, s->input.shift_down);
                         }
                     }
@@ -129,15 +133,15 @@ static void HandleLeftClick(AppState *s, SDL_MouseButtonEvent *event, int win_w,
             }
         } else if (s->ui.menu_state == 1) {
             if (btn_idx == 0) { // Toggle Miner
-                for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) {
-                    if (s->world.units.production_count[i] < MAX_PRODUCTION_QUEUE) {
-                        s->world.units.production_queue[i][s->world.units.production_count[i]++] = UNIT_MINER;
+                BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP) {
+                    if (s->world.production.count[i] < MAX_PRODUCTION_QUEUE) {
+                        s->world.production.queue[i][s->world.production.count[i]++] = UNIT_MINER;
                     }
                 }
             } else if (btn_idx == 1) { // Toggle Fighter
-                for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) {
-                    if (s->world.units.production_count[i] < MAX_PRODUCTION_QUEUE) {
-                        s->world.units.production_queue[i][s->world.units.production_count[i]++] = UNIT_FIGHTER;
+                BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP) {
+                    if (s->world.production.count[i] < MAX_PRODUCTION_QUEUE) {
+                        s->world.production.queue[i][s->world.production.count[i]++] = UNIT_FIGHTER;
                     }
                 }
             } else if (btn_idx == 10) s->ui.menu_state = 0; // Back
@@ -149,13 +153,12 @@ static void HandleLeftClick(AppState *s, SDL_MouseButtonEvent *event, int win_w,
     float wx = s->camera.pos.x + event->x / s->camera.zoom;
     float wy = s->camera.pos.y + event->y / s->camera.zoom;
     bool clicked_unit = false;
-    for (int i = 0; i < MAX_UNITS; i++) {
-        if (!s->world.units.active[i]) continue;
+    BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) {
         float dx = s->world.units.pos[i].x - wx, dy = s->world.units.pos[i].y - wy;
         float r = s->world.units.stats[i]->radius;
         if (dx * dx + dy * dy < r * r) {
-            if (!s->input.shift_down) SDL_memset(s->selection.unit_selected, 0, sizeof(s->selection.unit_selected));
-            s->selection.unit_selected[i] = true;
+            if (!s->input.shift_down) Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
+            Bits_Set(s->selection.unit_selected, i);
             s->selection.primary_unit_idx = i;
             clicked_unit = true;
             break;
@@ -173,12 +176,14 @@ static void HandleRightClick(AppState *s, SDL_MouseButtonEvent *event) {
     float wy = s->camera.pos.y + event->y / s->camera.zoom;
 
     int target_a = -1;
-    for (int a = 0; a < MAX_ASTEROIDS; a++) {
-        if (!s->world.asteroids.active[a]) continue;
+    int ids[SPATIAL_MAX_IDS];
+    int n = Spatial_QueryRadius(s, &s->world.grid, (Vec2){wx, wy}, s->world.grid.max_radius[SPATIAL_ASTEROID] * ASTEROID_HITBOX_MULT, SPATIAL_MASK(SPATIAL_ASTEROID), ids, SPATIAL_MAX_IDS);
+    for (int k = 0; k < n; k++) {
+        int a = ids[k];
         float dx = s->world.asteroids.pos[a].x - wx, dy = s->world.asteroids.pos[a].y - wy;
         float r = s->world.asteroids.radius[a] * ASTEROID_HITBOX_MULT;
         if (dx * dx + dy * dy < r * r) {
-            target_a = a;
+            target_a = Slots_AsteroidHandle(s, a);
             break;
         }
     }
@@ -189,7 +194,7 @@ static void HandleRightClick(AppState *s, SDL_MouseButtonEvent *event) {
     bool can_gather = false;
     bool can_attack = false;
     for (int i = 0; i < MAX_UNITS; i++) {
-        if (s->world.units.active[i] && s->selection.unit_selected[i]) {
+        if (Bits_Test(s->world.units.active, i) && Bits_Test(s->selection.unit_selected, i)) {
             if (s->world.units.type[i] == UNIT_MINER || s->world.units.type[i] == UNIT_MOTHERSHIP) can_gather = true;
             if (s->world.units.type[i] == UNIT_FIGHTER || s->world.units.type[i] == UNIT_MOTHERSHIP) can_attack = true;
         }
@@ -205,9 +210,9 @@ static void HandleRightClick(AppState *s, SDL_MouseButtonEvent *event) {
     else if (s->input.key_e_down) type = CMD_ATTACK_MOVE;
     else if (s->input.key_y_down) type = CMD_MAIN_CANNON;
     // 3. Contextual defaults
-    else if (s->input.hover_resource_idx != -1 && can_gather) {
+    else if (Slots_Resource(s, s->input.hover_resource) != -1 && can_gather) {
         type = CMD_GATHER;
-        target_a = s->input.hover_resource_idx;
+        target_a = s->input.hover_resource;
     } else {
         if (target_a != -1 && can_attack) {
             type = CMD_ATTACK_MOVE;
@@ -221,7 +226,7 @@ static void HandleRightClick(AppState *s, SDL_MouseButtonEvent *event) {
         return;
     }
 
-    Command cmd = { .pos = {wx, wy}, .target_idx = target_a, .type = type };
+    Command cmd = { .pos = {wx, wy}, .target = target_a, .type = type };
     Input_ScheduleCommand(s, cmd, s->input.shift_down);
 
     // Reset sticky command if not shifting
@@ -251,8 +256,8 @@ void Input_HandleMouseButtonUp(AppState *s, SDL_MouseButtonEvent *event) {
         
         bool any_selected = false;
         for (int i = 0; i < MAX_UNITS; i++) {
-            if (!s->world.units.active[i]) {
-                if (!s->input.shift_down) s->selection.unit_selected[i] = false;
+            if (!Bits_Test(s->world.units.active, i)) {
+                if (!s->input.shift_down) Bits_Clear(s->selection.unit_selected, i);
                 continue;
             }
             Vec2 sp = { 
@@ -260,11 +265,11 @@ void Input_HandleMouseButtonUp(AppState *s, SDL_MouseButtonEvent *event) {
                 (s->world.units.pos[i].y - s->camera.pos.y) * s->camera.zoom 
             };
             if (sp.x >= x1 && sp.x <= x2 && sp.y >= y1 && sp.y <= y2) {
-                s->selection.unit_selected[i] = true;
+                Bits_Set(s->selection.unit_selected, i);
                 s->selection.primary_unit_idx = i;
                 any_selected = true;
             } else if (!s->input.shift_down) {
-                s->selection.unit_selected[i] = false;
+                Bits_Clear(s->selection.unit_selected, i);
             }
         }
         if (!any_selected && !s->input.shift_down) s->selection.primary_unit_idx = -1;
@@ -292,12 +297,11 @@ void Input_HandleKeyDown(AppState *s, SDL_KeyboardEvent *event) {
     if (key >= SDLK_1 && key <= SDLK_9) {
         int g = key - SDLK_0;
         if (s->input.ctrl_down) {
-            SDL_memset(s->selection.group_members[g], 0, sizeof(s->selection.group_members[g]));
-            for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) s->selection.group_members[g][i] = true;
+            Bits_And(s->selection.group_members[g], s->world.units.active, s->selection.unit_selected, MAX_UNITS);
         } else {
             bool found = false;
-            if (!s->input.shift_down) SDL_memset(s->selection.unit_selected, 0, sizeof(s->selection.unit_selected));
-            for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.group_members[g][i]) { s->selection.unit_selected[i] = true; s->selection.primary_unit_idx = i; found = true; }
+            if (!s->input.shift_down) Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
+            BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.group_members[g], MAX_UNITS) { Bits_Set(s->selection.unit_selected, i); s->selection.primary_unit_idx = i; found = true; }
             if (found) s->ui.menu_state = 0;
         }
     }
@@ -305,15 +309,15 @@ void Input_HandleKeyDown(AppState *s, SDL_KeyboardEvent *event) {
     if (key == SDLK_Q) {
         s->input.key_q_down = true;
         if (s->ui.menu_state == 1) {
-            for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) {
-                if (s->world.units.production_mode[i] == UNIT_MINER) {
-                    s->world.units.production_mode[i] = UNIT_TYPE_COUNT;
+            BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP) {
+                if (s->world.production.mode[i] == UNIT_MINER) {
+                    s->world.production.mode[i] = UNIT_TYPE_COUNT;
                     UI_SetError(s, "MINER PRODUCTION OFF");
                 } else {
-                    s->world.units.production_mode[i] = UNIT_MINER;
+                    s->world.production.mode[i] = UNIT_MINER;
                     UI_SetError(s, "MINER PRODUCTION ON");
                 }
-                s->world.units.production_timer[i] = 0.0f;
+                s->world.production.timer[i] = 0.0f;
             }
         } else {
             s->input.pending_cmd_type = CMD_PATROL;
@@ -322,15 +326,15 @@ void Input_HandleKeyDown(AppState *s, SDL_KeyboardEvent *event) {
     if (key == SDLK_W) {
         s->input.key_w_down = true;
         if (s->ui.menu_state == 1) {
-            for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) {
-                if (s->world.units.production_mode[i] == UNIT_FIGHTER) {
-                    s->world.units.production_mode[i] = UNIT_TYPE_COUNT;
+            BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP) {
+                if (s->world.production.mode[i] == UNIT_FIGHTER) {
+                    s->world.production.mode[i] = UNIT_TYPE_COUNT;
                     UI_SetError(s, "FIGHTER PRODUCTION OFF");
                 } else {
-                    s->world.units.production_mode[i] = UNIT_FIGHTER;
+                    s->world.production.mode[i] = UNIT_FIGHTER;
                     UI_SetError(s, "FIGHTER PRODUCTION ON");
                 }
-                s->world.units.production_timer[i] = 0.0f;
+                s->world.production.timer[i] = 0.0f;
             }
         } else {
             s->input.pending_cmd_type = CMD_MOVE;
@@ -348,33 +352,33 @@ void Input_HandleKeyDown(AppState *s, SDL_KeyboardEvent *event) {
     
     if (key == SDLK_R) {
         s->input.key_r_down = true;
-        for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) { 
-            s->world.units.velocity[i] = (Vec2){0,0}; s->world.units.has_target[i] = false; 
-            s->world.units.command_count[i] = 0; s->world.units.command_current_idx[i] = 0; 
+        BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) { 
+            s->world.units.velocity[i] = (Vec2){0,0}; s->world.orders.has_target[i] = false; 
+            s->world.orders.count[i] = 0; s->world.orders.current_idx[i] = 0; 
         }
         s->ui.hold_flash_timer = 0.2f;
     }
-    if (key == SDLK_A) { s->input.key_a_down = true; for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) s->world.units.behavior[i] = BEHAVIOR_OFFENSIVE; s->ui.tactical_flash_timer = 0.2f; }
-    if (key == SDLK_S) { s->input.key_s_down = true; for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) s->world.units.behavior[i] = BEHAVIOR_DEFENSIVE; s->ui.tactical_flash_timer = 0.2f; }
-    if (key == SDLK_D) { s->input.key_d_down = true; for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i]) s->world.units.behavior[i] = BEHAVIOR_HOLD_GROUND; s->ui.tactical_flash_timer = 0.2f; }
+    if (key == SDLK_A) { s->input.key_a_down = true; BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) s->world.orders.behavior[i] = BEHAVIOR_OFFENSIVE; s->ui.tactical_flash_timer = 0.2f; }
+    if (key == SDLK_S) { s->input.key_s_down = true; BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) s->world.orders.behavior[i] = BEHAVIOR_DEFENSIVE; s->ui.tactical_flash_timer = 0.2f; }
+    if (key == SDLK_D) { s->input.key_d_down = true; BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) s->world.orders.behavior[i] = BEHAVIOR_HOLD_GROUND; s->ui.tactical_flash_timer = 0.2f; }
     
     // Quick Selection
     if (key == SDLK_F1) { // Miners
-        if (!s->input.shift_down) SDL_memset(s->selection.unit_selected, 0, sizeof(s->selection.unit_selected));
-        for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MINER) { s->selection.unit_selected[i] = true; s->selection.primary_unit_idx = i; }
+        if (!s->input.shift_down) Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
+        BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) if (s->world.units.type[i] == UNIT_MINER) { Bits_Set(s->selection.unit_selected, i); s->selection.primary_unit_idx = i; }
         s->ui.menu_state = 0;
     }
     if (key == SDLK_F2) { // Fighters
-        if (!s->input.shift_down) SDL_memset(s->selection.unit_selected, 0, sizeof(s->selection.unit_selected));
-        for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->world.units.type[i] == UNIT_FIGHTER) { s->selection.unit_selected[i] = true; s->selection.primary_unit_idx = i; }
+        if (!s->input.shift_down) Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
+        BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) if (s->world.units.type[i] == UNIT_FIGHTER) { Bits_Set(s->selection.unit_selected, i); s->selection.primary_unit_idx = i; }
         s->ui.menu_state = 0;
     }
     if (key == SDLK_F3) { // All Units
-        if (!s->input.shift_down) SDL_memset(s->selection.unit_selected, 0, sizeof(s->selection.unit_selected));
+        if (!s->input.shift_down) Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
         int m_idx = -1;
         for (int i = 0; i < MAX_UNITS; i++) {
-            if (s->world.units.active[i]) {
-                s->selection.unit_selected[i] = true;
+            if (Bits_Test(s->world.units.active, i)) {
+                Bits_Set(s->selection.unit_selected, i);
                 if (s->world.units.type[i] == UNIT_MOTHERSHIP) m_idx = i;
                 else if (m_idx == -1) s->selection.primary_unit_idx = i;
             }
@@ -385,10 +389,10 @@ void Input_HandleKeyDown(AppState *s, SDL_KeyboardEvent *event) {
 
     if (key == SDLK_F) {
         int m_idx = -1;
-        for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) { m_idx = i; break; }
+        BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP) { m_idx = i; break; }
         if (m_idx != -1) {
-            if (!s->input.shift_down) SDL_memset(s->selection.unit_selected, 0, sizeof(s->selection.unit_selected));
-            s->selection.unit_selected[m_idx] = true;
+            if (!s->input.shift_down) Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
+            Bits_Set(s->selection.unit_selected, m_idx);
             s->selection.primary_unit_idx = m_idx;
             s->ui.menu_state = 0;
         }
@@ -398,23 +402,23 @@ void Input_HandleKeyDown(AppState *s, SDL_KeyboardEvent *event) {
         s->input.key_x_down = true;
         if (s->ui.menu_state == 0) {
             bool has_mothership = false;
-            for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->selection.unit_selected[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) { has_mothership = true; break; }
+            BITS_FOR_EACH_AND(i, s->world.units.active, s->selection.unit_selected, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP) { has_mothership = true; break; }
             if (has_mothership) s->ui.menu_state = 1;
         }
     }
     
     if (key == SDLK_V) {
         for (int i = 0; i < MAX_UNITS; i++) {
-            if (s->world.units.active[i] && s->selection.unit_selected[i] && s->world.units.type[i] == UNIT_MINER) {
+            if (Bits_Test(s->world.units.active, i) && Bits_Test(s->selection.unit_selected, i) && s->world.units.type[i] == UNIT_MINER) {
                 int m_idx = -1; float min_d = 1e18;
                 for (int j = 0; j < MAX_UNITS; j++) {
-                    if (s->world.units.active[j] && s->world.units.type[j] == UNIT_MOTHERSHIP) {
+                    if (Bits_Test(s->world.units.active, j) && s->world.units.type[j] == UNIT_MOTHERSHIP) {
                         float d = Vector_DistanceSq(s->world.units.pos[i], s->world.units.pos[j]);
                         if (d < min_d) { min_d = d; m_idx = j; }
                     }
                 }
                 if (m_idx != -1) {
-                    Command cmd = { .pos = s->world.units.pos[m_idx], .target_idx = m_idx, .type = CMD_RETURN_CARGO };
+                    Command cmd = { .pos = s->world.units.pos[m_idx], .target = -1, .type = CMD_RETURN_CARGO };
                     Input_ScheduleCommand(s, cmd, s->input.shift_down);
                 }
             }
@@ -424,6 +428,8 @@ void Input_HandleKeyDown(AppState *s, SDL_KeyboardEvent *event) {
     if (key == SDLK_C) s->input.key_c_down = true;
     if (key == SDLK_G) s->input.show_grid = !s->input.show_grid;
     if (key == SDLK_D) s->input.show_density = !s->input.show_density;
+    if (key == SDLK_P) s->input.show_profiler = !s->input.show_profiler;
+    if (key == SDLK_T) { if (Trace_WriteChromeJson(s, "trace.json")) { UI_SetError(s, "TRACE SAVED"); } else { UI_SetError(s, "TRACE FAILED"); } }
     if (key == SDLK_K) { if (Persistence_SaveGame(s, "savegame.dat")) { UI_SetError(s, "GAME SAVED"); } else { UI_SetError(s, "SAVE FAILED"); } }
     if (key == SDLK_L) { if (Persistence_LoadGame(s, "savegame.dat")) { UI_SetError(s, "GAME LOADED"); } else { UI_SetError(s, "LOAD FAILED"); } }
 }
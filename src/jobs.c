@@ -0,0 +1,65 @@
+#include "jobs.h"
+#include "constants.h"
+
+static void RunChunks(JobPool *p) {
+  for (;;) {
+    int begin = SDL_AddAtomicInt(&p->next, p->grain);
+    if (begin >= p->count) return;
+    p->fn(p->ctx, begin, SDL_min(begin + p->grain, p->count));
+  }
+}
+
+static int SDLCALL WorkerThread(void *data) {
+  JobPool *p = (JobPool *)data;
+  for (;;) {
+    SDL_WaitSemaphore(p->start);
+    if (SDL_GetAtomicInt(&p->quit)) return 0;
+    RunChunks(p);
+    SDL_SignalSemaphore(p->done);
+  }
+}
+
+int Jobs_DefaultWorkerCount(void) {
+  return SDL_clamp(SDL_GetNumLogicalCPUCores() - 1, 0, JOBS_MAX_WORKERS);
+}
+
+void Jobs_Start(JobPool *p, int worker_count) {
+  SDL_memset(p, 0, sizeof(JobPool));
+  worker_count = SDL_clamp(worker_count, 0, JOBS_MAX_WORKERS);
+  if (worker_count == 0) return;
+  p->start = SDL_CreateSemaphore(0);
+  p->done = SDL_CreateSemaphore(0);
+  for (int i = 0; i < worker_count; i++) {
+    p->threads[i] = SDL_CreateThread(WorkerThread, "SimWorker", p);
+    if (!p->threads[i]) break;
+    p->worker_count++;
+  }
+}
+
+void Jobs_Stop(JobPool *p) {
+  SDL_SetAtomicInt(&p->quit, 1);
+  for (int i = 0; i < p->worker_count; i++) SDL_SignalSemaphore(p->start);
+  for (int i = 0; i < p->worker_count; i++) SDL_WaitThread(p->threads[i], NULL);
+  if (p->start) SDL_DestroySemaphore(p->start);
+  if (p->done) SDL_DestroySemaphore(p->done);
+  SDL_memset(p, 0, sizeof(JobPool));
+}
+
+void Jobs_ParallelFor(JobPool *p, int count, int grain, JobFn fn, void *ctx) {
+  if (count <= 0) return;
+  int chunks = (count + grain - 1) / grain;
+  if (p->worker_count == 0 || chunks == 1) {
+    fn(ctx, 0, count);
+    return;
+  }
+  p->fn = fn;
+  p->ctx = ctx;
+  p->count = count;
+  p->grain = grain;
+  SDL_SetAtomicInt(&p->next, 0);
+  // The semaphores publish the fields above to the workers
+  int wake = SDL_min(p->worker_count, chunks - 1);
+  for (int i = 0; i < wake; i++) SDL_SignalSemaphore(p->start);
+  RunChunks(p);
+  for (int i = 0; i < wake; i++) SDL_WaitSemaphore(p->done);
+}
@@ -6,13 +6,23 @@
 #include "assets.h"
 #include "ui.h"
 #include "workers.h"
+#include "profiler.h"
+#include "trace.h"
+#include "histogram.h"
+#include "counters.h"
+#include "footprint.h"
+#include "spatial.h"
+#include "jobs.h"
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
+#include <math.h>
+#include <stdio.h>
 
 SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
-  AppState *s = SDL_calloc(1, sizeof(AppState));
+  AppState *s = SDL_aligned_alloc(_Alignof(AppState), sizeof(AppState)); // The particle lanes ask for 64
   if (!s)
     return SDL_APP_FAILURE;
+  SDL_memset(s, 0, sizeof(AppState));
   *appstate = s;
 
   if (!SDL_Init(SDL_INIT_VIDEO))
@@ -40,7 +50,32 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[]) {
   s->input.show_grid = true;
   s->selection.primary_unit_idx = -1;
 
+  int tick_rate = SIM_TICK_RATE;
+  Uint64 seed = SDL_GetPerformanceCounter();
+  BroadphaseMode broadphase = BROADPHASE_GRID;
+  int jobs = Jobs_DefaultWorkerCount();
+  for (int i = 1; i < argc; i++) {
+    if (SDL_strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) tick_rate = SDL_atoi(argv[++i]);
+    else if (SDL_strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = SDL_strtoull(argv[++i], NULL, 10);
+    else if (SDL_strcmp(argv[i], "--counters") == 0 && i + 1 < argc) {
+      if (!Counters_Open(s, argv[++i])) SDL_Log("Failed to open %s", argv[i]);
+    }
+    else if (SDL_strcmp(argv[i], "--broadphase") == 0 && i + 1 < argc) {
+      if (!Spatial_ParseBroadphase(argv[++i], &broadphase)) SDL_Log("Unknown broadphase %s, using grid", argv[i]);
+    }
+    else if (SDL_strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) jobs = SDL_atoi(argv[++i]);
+  }
+  if (tick_rate <= 0) tick_rate = SIM_TICK_RATE;
+  s->sim_dt = 1.0f / (float)tick_rate;
+  s->render_alpha = 1.0f;
+  Trace_Init(s);
+  SDL_GetRenderOutputSize(s->renderer, &s->camera.view_w, &s->camera.view_h);
+
+  Game_Seed(s, seed);
   Game_Init(s);
+  s->world.broadphase = broadphase;
+  Jobs_Start(&s->jobs, jobs);
+  Footprint_LogReport(s);
   Renderer_Init(s); // Only sets up textures, doesn't start threads yet
 
   return SDL_APP_CONTINUE;
@@ -105,6 +140,27 @@ SDL_AppResult SDL_AppEvent(void *appstate, SDL_Event *event) {
   return SDL_APP_CONTINUE;
 }
 
+static void LogStutter(const AppState *s, double frame_ms, double median_ms) {
+  static const char *state_names[] = {"launcher", "loading", "game", "paused", "gameover"};
+  FILE *f = fopen(STUTTER_LOG_FILE, "a");
+  if (!f) return;
+  int particles = s->world.slots.particles.live_count;
+  fprintf(f, "t=%.2f frame=%.2fms median=%.2fms asteroids=%d units=%d resources=%d particles=%d state=%s\n",
+          s->current_time, frame_ms, median_ms, s->world.asteroid_count, s->world.unit_count, s->world.resource_count, particles, state_names[s->game_state]);
+  fclose(f);
+}
+
+// Stutter check runs against the window before this frame is added
+static void RecordFrameTime(AppState *s, double frame_ms) {
+  Histogram *h = &s->frame_stats.frame_hist;
+  double median = Histogram_Percentile(h, 0.5);
+  if (h->count >= STUTTER_MIN_SAMPLES && frame_ms > median * STUTTER_FACTOR) {
+    s->frame_stats.stutter_count++;
+    LogStutter(s, frame_ms, median);
+  }
+  Histogram_Record(h, frame_ms);
+}
+
 SDL_AppResult SDL_AppIterate(void *appstate) {
   AppState *s = (AppState *)appstate;
   
@@ -125,6 +181,12 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
   float dt = (now - last_time) / 1000.0f;
   last_time = now;
 
+  // Sub-millisecond frame interval for the frame-time histogram
+  static Uint64 last_counter = 0;
+  Uint64 counter = SDL_GetPerformanceCounter();
+  double frame_ms = last_counter ? (double)(counter - last_counter) * 1000.0 / (double)SDL_GetPerformanceFrequency() : 0.0;
+  last_counter = counter;
+
   // FPS Calculation
   frame_count++;
   Uint64 elapsed = now - fps_timer;
@@ -140,8 +202,28 @@ SDL_AppResult SDL_AppIterate(void *appstate) {
     Asset_GenerateStep(s);
     Asset_DrawLoading(s);
   } else if (s->game_state == STATE_GAME || s->game_state == STATE_PAUSED || s->game_state == STATE_GAMEOVER) {
-    Game_Update(s, dt);
+    SDL_GetRenderOutputSize(s->renderer, &s->camera.view_w, &s->camera.view_h);
+    Profiler_BeginFrame(s);
+    if (s->game_state == STATE_PAUSED) {
+      // Hold the last tick on screen while paused
+      s->sim_accumulator = 0.0f;
+      s->render_alpha = 1.0f;
+    } else {
+      // Fixed-step sim, render blends the remainder
+      s->sim_accumulator += fminf(dt, SIM_MAX_FRAME_TIME);
+      while (s->sim_accumulator >= s->sim_dt) {
+        Uint64 tick_start = SDL_GetPerformanceCounter();
+        Game_Update(s, s->sim_dt);
+        double tick_ms = (double)(SDL_GetPerformanceCounter() - tick_start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+        Histogram_Record(&s->frame_stats.tick_hist, tick_ms);
+        Counters_EndTick(s, tick_ms);
+        s->sim_accumulator -= s->sim_dt;
+      }
+      s->render_alpha = s->sim_accumulator / s->sim_dt;
+    }
     Renderer_Draw(s);
+    Profiler_EndFrame(s);
+    if (frame_ms > 0.0) RecordFrameTime(s, frame_ms);
   }
 
   return SDL_APP_CONTINUE;
@@ -180,6 +262,8 @@ void SDL_AppQuit(void *appstate, SDL_AppResult result) {
     if (s->threads.mothership_hull_buffer) SDL_free(s->threads.mothership_hull_buffer);
     if (s->threads.mothership_arm_buffer) SDL_free(s->threads.mothership_arm_buffer);
 
-    SDL_free(s);
+    Jobs_Stop(&s->jobs);
+    Counters_Close(s);
+    SDL_aligned_free(s);
   }
 }
@@ -2,8 +2,25 @@
 #include "utils.h"
 #include "constants.h"
 #include "game.h"
+#include "rng.h"
+#include "slots.h"
 #include <math.h>
 #include <stdlib.h>
+#if PHYSICS_SIMD && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define PARTICLES_SSE2 1
+#endif
+
+int Particles_Alloc(AppState *s) {
+  s->counters.particles_allocated++;
+  int idx = Slots_AllocParticle(s);
+  if (idx >= 0) return idx;
+  // Pool full: overwrite live particles round-robin
+  idx = s->world.particle_next_idx;
+  s->counters.particles_overwritten++;
+  s->world.particle_next_idx = (idx + 1) % MAX_PARTICLES;
+  return idx;
+}
 
 void Particles_SpawnExplosion(AppState *s, Vec2 pos, int count, float size_mult, ExplosionType type, int asteroid_tex_idx) {
   float capped_mult = powf(size_mult, 0.5f) * 0.8f; 
@@ -19,148 +36,128 @@ void Particles_SpawnExplosion(AppState *s, Vec2 pos, int count, float size_mult,
   if (type == EXPLOSION_IMPACT) {
       int spark_count = (int)(count * 1.5f * count_mult); 
       for (int i = 0; i < spark_count; i++) {
-        int idx = s->world.particle_next_idx;
-        s->world.particles.active[idx] = true;
+        int idx = Particles_Alloc(s);
         s->world.particles.type[idx] = PARTICLE_SPARK;
-        s->world.particles.pos[idx] = pos;
-        float angle = (float)(rand() % 360) * 0.0174533f;
-        float speed = (float)(rand() % 200 + 50) * capped_mult; // Reduced from 600+200
-        s->world.particles.velocity[idx].x = cosf(angle) * speed;
-        s->world.particles.velocity[idx].y = sinf(angle) * speed;
+        Particles_SetPos(s, idx, pos);
+        float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+        float speed = (float)(Rng_Int(&s->world.rng_vfx, 200) + 50) * capped_mult; // Reduced from 600+200
+        s->world.particles.vel_x[idx] = cosf(angle) * speed;
+        s->world.particles.vel_y[idx] = sinf(angle) * speed;
         s->world.particles.life[idx] = PARTICLE_LIFE_BASE * 0.4f; // Reduced from 0.5f
-        s->world.particles.size[idx] = (float)(rand() % 10 + 5) * capped_mult;
+        s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 10) + 5) * capped_mult;
         s->world.particles.color[idx] = (SDL_Color){(Uint8)((base_col.r + 255)/2), (Uint8)((base_col.g + 220)/2), (Uint8)((base_col.b + 150)/2), 255};
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
       }
       int puff_count = (int)(count * 0.8f * count_mult); 
       for (int i = 0; i < puff_count; i++) {
-        int idx = s->world.particle_next_idx;
-        s->world.particles.active[idx] = true;
+        int idx = Particles_Alloc(s);
         s->world.particles.type[idx] = PARTICLE_PUFF;
-        s->world.particles.pos[idx] = pos;
-        float angle = (float)(rand() % 360) * 0.0174533f;
-        float speed = (float)(rand() % 50 + 20) * capped_mult; // Reduced from 150+60
-        s->world.particles.velocity[idx].x = cosf(angle) * speed;
-        s->world.particles.velocity[idx].y = sinf(angle) * speed;
+        Particles_SetPos(s, idx, pos);
+        float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+        float speed = (float)(Rng_Int(&s->world.rng_vfx, 50) + 20) * capped_mult; // Reduced from 150+60
+        s->world.particles.vel_x[idx] = cosf(angle) * speed;
+        s->world.particles.vel_y[idx] = sinf(angle) * speed;
         s->world.particles.life[idx] = PARTICLE_LIFE_BASE * 0.4f; // Reduced from 0.5f
-        s->world.particles.size[idx] = (float)(rand() % 120 + 60) * capped_mult;
-        Uint8 v = (Uint8)(rand() % 40 + 80); 
+        s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 120) + 60) * capped_mult;
+        Uint8 v = (Uint8)(Rng_Int(&s->world.rng_vfx, 40) + 80); 
         s->world.particles.color[idx] = (SDL_Color){v, (Uint8)(v * 0.8f), (Uint8)(v * 0.6f), 255};
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
       }
       int fine_debris_count = (int)(8 * count_mult); 
       for (int i = 0; i < fine_debris_count; i++) {
-          int idx = s->world.particle_next_idx;
-          s->world.particles.active[idx] = true;
+          int idx = Particles_Alloc(s);
           s->world.particles.type[idx] = PARTICLE_DEBRIS;
           s->world.particles.asteroid_tex_idx[idx] = asteroid_tex_idx;
-          s->world.particles.pos[idx] = pos;
-          s->world.particles.tex_idx[idx] = rand() % DEBRIS_COUNT;
-          float angle = (float)(rand() % 360) * 0.0174533f;
-          float speed = (float)(rand() % 80 + 20) * capped_mult; // Reduced from 250+80
-          s->world.particles.velocity[idx].x = cosf(angle) * speed;
-          s->world.particles.velocity[idx].y = sinf(angle) * speed;
+          Particles_SetPos(s, idx, pos);
+          s->world.particles.tex_idx[idx] = Rng_Int(&s->world.rng_vfx, DEBRIS_COUNT);
+          float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+          float speed = (float)(Rng_Int(&s->world.rng_vfx, 80) + 20) * capped_mult; // Reduced from 250+80
+          s->world.particles.vel_x[idx] = cosf(angle) * speed;
+          s->world.particles.vel_y[idx] = sinf(angle) * speed;
           s->world.particles.life[idx] = PARTICLE_LIFE_BASE * 0.3f; // Reduced from 0.35f
-          s->world.particles.size[idx] = (float)(rand() % 18 + 12) * chunky_mult;
-          s->world.particles.rotation[idx] = (float)(rand() % 360);
+          s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 18) + 12) * chunky_mult;
+          s->world.particles.rotation[idx] = (float)Rng_Int(&s->world.rng_vfx, 360);
           s->world.particles.color[idx] = base_col;
-          s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
       }
       int debris_count = (int)(3 * count_mult); 
       for (int i = 0; i < debris_count; i++) {
-          int idx = s->world.particle_next_idx;
-          s->world.particles.active[idx] = true;
+          int idx = Particles_Alloc(s);
           s->world.particles.type[idx] = PARTICLE_DEBRIS;
           s->world.particles.asteroid_tex_idx[idx] = asteroid_tex_idx;
-          s->world.particles.pos[idx] = pos;
-          s->world.particles.tex_idx[idx] = rand() % DEBRIS_COUNT;
-          float angle = (float)(rand() % 360) * 0.0174533f;
-          float speed = (float)(rand() % 50 + 20) * capped_mult; // Reduced from 150+60
-          s->world.particles.velocity[idx].x = cosf(angle) * speed;
-          s->world.particles.velocity[idx].y = sinf(angle) * speed;
+          Particles_SetPos(s, idx, pos);
+          s->world.particles.tex_idx[idx] = Rng_Int(&s->world.rng_vfx, DEBRIS_COUNT);
+          float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+          float speed = (float)(Rng_Int(&s->world.rng_vfx, 50) + 20) * capped_mult; // Reduced from 150+60
+          s->world.particles.vel_x[idx] = cosf(angle) * speed;
+          s->world.particles.vel_y[idx] = sinf(angle) * speed;
           s->world.particles.life[idx] = PARTICLE_LIFE_BASE * 0.4f; // Reduced from 0.45f
-          s->world.particles.size[idx] = (float)(rand() % 45 + 35) * chunky_mult;
-          s->world.particles.rotation[idx] = (float)(rand() % 360);
+          s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 45) + 35) * chunky_mult;
+          s->world.particles.rotation[idx] = (float)Rng_Int(&s->world.rng_vfx, 360);
           s->world.particles.color[idx] = base_col;
-          s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
       }
-      int sw_idx = s->world.particle_next_idx;
-      s->world.particles.active[sw_idx] = true;
+      int sw_idx = Particles_Alloc(s);
       s->world.particles.type[sw_idx] = PARTICLE_SHOCKWAVE;
-      s->world.particles.pos[sw_idx] = pos;
-      s->world.particles.velocity[sw_idx] = (Vec2){0,0};
+      Particles_SetPos(s, sw_idx, pos);
+      Particles_SetVelocity(s, sw_idx, (Vec2){0,0});
       s->world.particles.life[sw_idx] = 0.6f; 
       s->world.particles.size[sw_idx] = 100.0f * capped_mult;
       s->world.particles.color[sw_idx] = (SDL_Color){255, 255, 200, 80}; // Alpha 200 -> 80
-      s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
   } else {
       int puff_count = (int)(count * 0.7f * count_mult); 
       for (int i = 0; i < puff_count; i++) {
-        int idx = s->world.particle_next_idx;
-        s->world.particles.active[idx] = true;
+        int idx = Particles_Alloc(s);
         s->world.particles.type[idx] = PARTICLE_PUFF;
-        s->world.particles.pos[idx] = pos;
-        float angle = (float)(rand() % 360) * 0.0174533f;
-        float speed = (float)(rand() % 100 + 20) * capped_mult; // Reduced from 200+40
-        s->world.particles.velocity[idx].x = cosf(angle) * speed;
-        s->world.particles.velocity[idx].y = sinf(angle) * speed;
-        s->world.particles.life[idx] = PARTICLE_LIFE_BASE * (0.8f + 0.4f * (float)rand()/(float)RAND_MAX); // Reduced from 1.5+0.5
-        s->world.particles.size[idx] = (float)(rand() % 150 + 80) * capped_mult;
-        Uint8 v = (Uint8)(rand() % 40 + 60); 
+        Particles_SetPos(s, idx, pos);
+        float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+        float speed = (float)(Rng_Int(&s->world.rng_vfx, 100) + 20) * capped_mult; // Reduced from 200+40
+        s->world.particles.vel_x[idx] = cosf(angle) * speed;
+        s->world.particles.vel_y[idx] = sinf(angle) * speed;
+        s->world.particles.life[idx] = PARTICLE_LIFE_BASE * (0.8f + 0.4f * Rng_Float(&s->world.rng_vfx)); // Reduced from 1.5+0.5
+        s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 150) + 80) * capped_mult;
+        Uint8 v = (Uint8)(Rng_Int(&s->world.rng_vfx, 40) + 60); 
         s->world.particles.color[idx] = (SDL_Color){v, (Uint8)(v * 0.95f), (Uint8)(v * 0.9f), 255};
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
       }
       int debris_count = (int)(8 * count_mult); 
       for (int i = 0; i < debris_count; i++) {
-          int idx = s->world.particle_next_idx;
-          s->world.particles.active[idx] = true;
+          int idx = Particles_Alloc(s);
           s->world.particles.type[idx] = PARTICLE_DEBRIS;
           s->world.particles.asteroid_tex_idx[idx] = asteroid_tex_idx;
-          s->world.particles.pos[idx] = pos;
-          s->world.particles.tex_idx[idx] = rand() % DEBRIS_COUNT;
-          float angle = (float)(rand() % 360) * 0.0174533f;
-          float speed = (float)(rand() % 100 + 40) * capped_mult; // Reduced from 200+80
-          s->world.particles.velocity[idx].x = cosf(angle) * speed;
-          s->world.particles.velocity[idx].y = sinf(angle) * speed;
+          Particles_SetPos(s, idx, pos);
+          s->world.particles.tex_idx[idx] = Rng_Int(&s->world.rng_vfx, DEBRIS_COUNT);
+          float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+          float speed = (float)(Rng_Int(&s->world.rng_vfx, 100) + 40) * capped_mult; // Reduced from 200+80
+          s->world.particles.vel_x[idx] = cosf(angle) * speed;
+          s->world.particles.vel_y[idx] = sinf(angle) * speed;
           s->world.particles.life[idx] = PARTICLE_LIFE_BASE * 0.8f; // Reduced from 0.8f but check speed
-          s->world.particles.size[idx] = (float)(rand() % 60 + 30) * chunky_mult;
-          s->world.particles.rotation[idx] = (float)(rand() % 360);
+          s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 60) + 30) * chunky_mult;
+          s->world.particles.rotation[idx] = (float)Rng_Int(&s->world.rng_vfx, 360);
           s->world.particles.color[idx] = base_col;
-          s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
       }
-      int sw_idx = s->world.particle_next_idx;
-      s->world.particles.active[sw_idx] = true;
+      int sw_idx = Particles_Alloc(s);
       s->world.particles.type[sw_idx] = PARTICLE_SHOCKWAVE;
-      s->world.particles.pos[sw_idx] = pos;
-      s->world.particles.velocity[sw_idx] = (Vec2){0,0};
+      Particles_SetPos(s, sw_idx, pos);
+      Particles_SetVelocity(s, sw_idx, (Vec2){0,0});
       s->world.particles.life[sw_idx] = 0.8f;
       s->world.particles.size[sw_idx] = (float)(80.0f * capped_mult); 
       s->world.particles.color[sw_idx] = (SDL_Color){255, 255, 255, 60}; // Alpha 150 -> 60
-      s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
   }
 }
 
 void Particles_SpawnLaserFlash(AppState *s, Vec2 pos, float size, SDL_Color color, bool is_impact) {
-    int m_idx = s->world.particle_next_idx;
-    s->world.particles.active[m_idx] = true;
+    int m_idx = Particles_Alloc(s);
     s->world.particles.type[m_idx] = PARTICLE_GLOW; 
-    s->world.particles.pos[m_idx] = pos;
-    s->world.particles.velocity[m_idx] = (Vec2){0, 0};
+    Particles_SetPos(s, m_idx, pos);
+    Particles_SetVelocity(s, m_idx, (Vec2){0, 0});
     s->world.particles.life[m_idx] = MUZZLE_FLASH_LIFE;
     s->world.particles.size[m_idx] = size * MUZZLE_FLASH_SIZE_MULT;
     s->world.particles.color[m_idx] = color;
-    s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
 
     if (is_impact) {
-        int i_g_idx = s->world.particle_next_idx;
-        s->world.particles.active[i_g_idx] = true;
+        int i_g_idx = Particles_Alloc(s);
         s->world.particles.type[i_g_idx] = PARTICLE_GLOW;
-        s->world.particles.pos[i_g_idx] = pos;
-        s->world.particles.velocity[i_g_idx] = (Vec2){0, 0};
+        Particles_SetPos(s, i_g_idx, pos);
+        Particles_SetVelocity(s, i_g_idx, (Vec2){0, 0});
         s->world.particles.life[i_g_idx] = 0.25f;
         s->world.particles.size[i_g_idx] = size * 12.0f;
         s->world.particles.color[i_g_idx] = (SDL_Color){255, 255, 255, 255};
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
     }
 }
 
@@ -173,97 +170,140 @@ void Particles_SpawnMiningEffect(AppState *s, Vec2 crystal_pos, Vec2 unit_pos, f
     if (spark_count < 3) spark_count = 3; 
     
     for (int i = 0; i < spark_count; i++) {
-        int idx = s->world.particle_next_idx;
-        s->world.particles.active[idx] = true;
+        int idx = Particles_Alloc(s);
         s->world.particles.type[idx] = PARTICLE_SPARK;
-        s->world.particles.pos[idx] = crystal_pos;
-        float angle = (float)(rand() % 360) * 0.0174533f;
-        float speed = (float)(rand() % 500 + 200);
-        s->world.particles.velocity[idx].x = cosf(angle) * speed;
-        s->world.particles.velocity[idx].y = sinf(angle) * speed;
+        Particles_SetPos(s, idx, crystal_pos);
+        float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+        float speed = (float)(Rng_Int(&s->world.rng_vfx, 500) + 200);
+        s->world.particles.vel_x[idx] = cosf(angle) * speed;
+        s->world.particles.vel_y[idx] = sinf(angle) * speed;
         s->world.particles.life[idx] = 0.4f;
-        s->world.particles.size[idx] = (float)(rand() % 8 + 4);
+        s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 8) + 4);
         s->world.particles.color[idx] = (SDL_Color){100, 255, 220, 255}; // Brighter cyan
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
     }
 
     // 2. Dust Puffs
     int puff_count = (int)(effective_intensity * 0.8f);
     if (puff_count < 2) puff_count = 2;
     for (int i = 0; i < puff_count; i++) {
-        int idx = s->world.particle_next_idx;
-        s->world.particles.active[idx] = true;
+        int idx = Particles_Alloc(s);
         s->world.particles.type[idx] = PARTICLE_PUFF;
-        s->world.particles.pos[idx] = crystal_pos;
-        float angle = (float)(rand() % 360) * 0.0174533f;
-        float speed = (float)(rand() % 150 + 80);
-        s->world.particles.velocity[idx].x = cosf(angle) * speed;
-        s->world.particles.velocity[idx].y = sinf(angle) * speed;
+        Particles_SetPos(s, idx, crystal_pos);
+        float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+        float speed = (float)(Rng_Int(&s->world.rng_vfx, 150) + 80);
+        s->world.particles.vel_x[idx] = cosf(angle) * speed;
+        s->world.particles.vel_y[idx] = sinf(angle) * speed;
         s->world.particles.life[idx] = 0.7f;
-        s->world.particles.size[idx] = (float)(rand() % 80 + 50); 
+        s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 80) + 50); 
         s->world.particles.color[idx] = (SDL_Color){80, 220, 255, 140}; // More opaque blue/cyan dust
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
     }
 
     // 3. Resource Stream (bits that flow toward the unit)
-    if (rand() % 100 < 60) { // Much more frequent
-        int idx = s->world.particle_next_idx;
-        s->world.particles.active[idx] = true;
+    if (Rng_Int(&s->world.rng_vfx, 100) < 60) { // Much more frequent
+        int idx = Particles_Alloc(s);
         s->world.particles.type[idx] = PARTICLE_PUFF;
-        s->world.particles.pos[idx] = crystal_pos;
+        Particles_SetPos(s, idx, crystal_pos);
         
         Vec2 dir = Vector_Normalize(Vector_Sub(unit_pos, crystal_pos));
-        float speed = (float)(rand() % 400 + 500);
-        s->world.particles.velocity[idx] = Vector_Scale(dir, speed);
-        s->world.particles.target_pos[idx] = unit_pos; 
+        float speed = (float)(Rng_Int(&s->world.rng_vfx, 400) + 500);
+        Particles_SetVelocity(s, idx, Vector_Scale(dir, speed));
         
         s->world.particles.life[idx] = 0.8f;
-        s->world.particles.size[idx] = (float)(rand() % 40 + 30); 
+        s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 40) + 30); 
         s->world.particles.color[idx] = (SDL_Color){255, 255, 150, 255}; // Brighter yellow bits
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
     }
 }
 
 void Particles_SpawnTeleport(AppState *s, Vec2 pos, float size) {
     // Spark implosion
     for (int i = 0; i < 40; i++) {
-        int idx = s->world.particle_next_idx;
-        s->world.particles.active[idx] = true;
+        int idx = Particles_Alloc(s);
         s->world.particles.type[idx] = PARTICLE_SPARK;
-        float angle = (float)(rand() % 360) * 0.0174533f;
-        float dist = size * (2.0f + (float)rand()/(float)RAND_MAX);
-        s->world.particles.pos[idx] = (Vec2){pos.x + cosf(angle) * dist, pos.y + sinf(angle) * dist};
-        s->world.particles.velocity[idx] = Vector_Scale(Vector_Normalize(Vector_Sub(pos, s->world.particles.pos[idx])), dist * 2.0f);
+        float angle = (float)Rng_Int(&s->world.rng_vfx, 360) * 0.0174533f;
+        float dist = size * (2.0f + Rng_Float(&s->world.rng_vfx));
+        Particles_SetPos(s, idx, (Vec2){pos.x + cosf(angle) * dist, pos.y + sinf(angle) * dist});
+        Particles_SetVelocity(s, idx, Vector_Scale(Vector_Normalize(Vector_Sub(pos, Particles_Pos(s, idx))), dist * 2.0f));
         s->world.particles.life[idx] = 0.5f;
-        s->world.particles.size[idx] = (float)(rand() % 10 + 5);
+        s->world.particles.size[idx] = (float)(Rng_Int(&s->world.rng_vfx, 10) + 5);
         s->world.particles.color[idx] = (SDL_Color){100, 200, 255, 255};
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
     }
     // Shockwave
-    int sw_idx = s->world.particle_next_idx;
-    s->world.particles.active[sw_idx] = true;
+    int sw_idx = Particles_Alloc(s);
     s->world.particles.type[sw_idx] = PARTICLE_SHOCKWAVE;
-    s->world.particles.pos[sw_idx] = pos;
-    s->world.particles.velocity[sw_idx] = (Vec2){0,0};
+    Particles_SetPos(s, sw_idx, pos);
+    Particles_SetVelocity(s, sw_idx, (Vec2){0,0});
     s->world.particles.life[sw_idx] = 0.4f; 
     s->world.particles.size[sw_idx] = size;
     s->world.particles.color[sw_idx] = (SDL_Color){150, 230, 255, 255}; 
-    s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
+}
+
+void Particles_SpawnCollisionVfx(AppState *s) {
+  const CollisionEvents *e = &s->world.collision_events;
+  if (e->skip_vfx) return;
+  int spawned = 0;
+  for (int k = 0; k < e->count && spawned < COLLISION_VFX_BUDGET; k++) {
+    const CollisionEvent *ev = &e->events[k];
+    if (ev->type == COLLISION_ASTEROID_SPLIT) Particles_SpawnExplosion(s, ev->point, 20, ev->magnitude / 500.0f, EXPLOSION_COLLISION, ev->tex_idx);
+    else if (ev->type == COLLISION_ASTEROID_DESTROYED) Particles_SpawnExplosion(s, ev->point, 40, ev->magnitude / 200.0f, EXPLOSION_COLLISION, ev->tex_idx);
+    else continue;
+    spawned++;
+  }
+}
+
+// Snapshots prev and advances every drifting particle along the x/y lanes. Walks the
+// occupancy words, skipping empty ones; the SSE2 path handles four slots per op and masks
+// inactive slots out of every write. Tracers and shockwaves stay where they were spawned.
+static void IntegrateLanes(ParticlePool *p, float dt) {
+  for (int w = 0; w < BITS_WORDS(MAX_PARTICLES); w++) {
+    Uint64 bits = p->active[w];
+    if (!bits) continue;
+#ifdef PARTICLES_SSE2
+    const __m128 step = _mm_set1_ps(dt);
+    const __m128i zero = _mm_setzero_si128();
+    for (int g = 0; g < 64; g += 4) {
+      unsigned lanes = (unsigned)(bits >> g) & 0xF;
+      if (!lanes) continue;
+      int i = w * 64 + g;
+      __m128 live = _mm_castsi128_ps(_mm_set_epi32(-(int)((lanes >> 3) & 1), -(int)((lanes >> 2) & 1), -(int)((lanes >> 1) & 1), -(int)(lanes & 1)));
+      Uint32 types;
+      SDL_memcpy(&types, &p->type[i], sizeof(types));
+      __m128i t = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)types), zero), zero);
+      __m128i still = _mm_or_si128(_mm_cmpeq_epi32(t, _mm_set1_epi32(PARTICLE_TRACER)), _mm_cmpeq_epi32(t, _mm_set1_epi32(PARTICLE_SHOCKWAVE)));
+      __m128 move = _mm_andnot_ps(_mm_castsi128_ps(still), live);
+
+      __m128 px = _mm_load_ps(&p->pos_x[i]), py = _mm_load_ps(&p->pos_y[i]);
+      __m128 qx = _mm_load_ps(&p->prev_x[i]), qy = _mm_load_ps(&p->prev_y[i]);
+      _mm_store_ps(&p->prev_x[i], _mm_or_ps(_mm_and_ps(live, px), _mm_andnot_ps(live, qx)));
+      _mm_store_ps(&p->prev_y[i], _mm_or_ps(_mm_and_ps(live, py), _mm_andnot_ps(live, qy)));
+      __m128 nx = _mm_add_ps(px, _mm_mul_ps(_mm_load_ps(&p->vel_x[i]), step));
+      __m128 ny = _mm_add_ps(py, _mm_mul_ps(_mm_load_ps(&p->vel_y[i]), step));
+      _mm_store_ps(&p->pos_x[i], _mm_or_ps(_mm_and_ps(move, nx), _mm_andnot_ps(move, px)));
+      _mm_store_ps(&p->pos_y[i], _mm_or_ps(_mm_and_ps(move, ny), _mm_andnot_ps(move, py)));
+    }
+#else
+    for (; bits; bits &= bits - 1) {
+      int i = w * 64 + Bits_Ctz(bits);
+      p->prev_x[i] = p->pos_x[i];
+      p->prev_y[i] = p->pos_y[i];
+      if (p->type[i] == PARTICLE_TRACER || p->type[i] == PARTICLE_SHOCKWAVE) continue;
+      p->pos_x[i] += p->vel_x[i] * dt;
+      p->pos_y[i] += p->vel_y[i] * dt;
+    }
+#endif
+  }
 }
 
 void Particles_Update(AppState *s, float dt) {
-  for (int i = 0; i < MAX_PARTICLES; i++) {
-    if (!s->world.particles.active[i]) continue;
+  IntegrateLanes(&s->world.particles, dt);
+  // Backwards, so the live slot swapped into a freed one's place has already been updated
+  for (int k = s->world.slots.particles.live_count - 1; k >= 0; k--) {
+    int i = s->world.slots.particles.live[k];
     if (s->world.particles.type[i] == PARTICLE_TRACER) s->world.particles.life[i] -= dt * 2.0f;
     else if (s->world.particles.type[i] == PARTICLE_SHOCKWAVE) {
         s->world.particles.life[i] -= dt * 0.8f; // Slower decay
         s->world.particles.size[i] += dt * 600.0f; // Slower expansion
     }
-    else { 
-        s->world.particles.pos[i].x += s->world.particles.velocity[i].x * dt;
-        s->world.particles.pos[i].y += s->world.particles.velocity[i].y * dt;
-        s->world.particles.life[i] -= dt * PARTICLE_LIFE_DECAY; 
-    }
-    if (s->world.particles.life[i] <= 0) s->world.particles.active[i] = false;
+    else s->world.particles.life[i] -= dt * PARTICLE_LIFE_DECAY;
+    if (s->world.particles.life[i] <= 0) Slots_FreeParticle(s, i);
   }
 }
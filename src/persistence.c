@@ -1,9 +1,11 @@
 #include "persistence.h"
+#include "game.h"
+#include "slots.h"
 #include <stdio.h>
 #include <stdlib.h>
 
 #define SAVE_MAGIC 0x41535452 // "ASTR"
-#define SAVE_VERSION 1
+#define SAVE_VERSION 7
 
 typedef struct {
     uint32_t magic;
@@ -35,8 +37,16 @@ bool Persistence_SaveGame(const AppState *s, const char *filename) {
 
     // 2. Entities
     fwrite(&s->world.units, sizeof(UnitPool), 1, f);
+    fwrite(&s->world.orders, sizeof(UnitOrderPool), 1, f);
+    fwrite(&s->world.targets, sizeof(UnitTargetPool), 1, f);
+    fwrite(&s->world.production, sizeof(ProductionPool), 1, f);
     fwrite(&s->world.asteroids, sizeof(AsteroidPool), 1, f);
     fwrite(&s->world.resources, sizeof(ResourcePool), 1, f);
+    fwrite(&s->world.slots, sizeof(SlotLists), 1, f); // Generations keep saved handles valid
+
+    // 3. Gameplay RNG, so a loaded game continues the same sequence
+    fwrite(&s->world.seed, sizeof(Uint64), 1, f);
+    fwrite(&s->world.rng_sim, sizeof(Rng), 1, f);
 
     fclose(f);
     return true;
@@ -59,18 +69,29 @@ bool Persistence_LoadGame(AppState *s, const char *filename) {
 
     // 2. Entities
     fread(&s->world.units, sizeof(UnitPool), 1, f);
+    fread(&s->world.orders, sizeof(UnitOrderPool), 1, f);
+    fread(&s->world.targets, sizeof(UnitTargetPool), 1, f);
+    fread(&s->world.production, sizeof(ProductionPool), 1, f);
     fread(&s->world.asteroids, sizeof(AsteroidPool), 1, f);
     fread(&s->world.resources, sizeof(ResourcePool), 1, f);
+    fread(&s->world.slots, sizeof(SlotLists), 1, f);
+
+    // 3. Gameplay RNG
+    fread(&s->world.seed, sizeof(Uint64), 1, f);
+    fread(&s->world.rng_sim, sizeof(Rng), 1, f);
 
     // Re-link pointers
     for (int i = 0; i < MAX_UNITS; i++) {
-        if (s->world.units.active[i]) {
+        if (Bits_Test(s->world.units.active, i)) {
             s->world.units.stats[i] = &s->world.unit_stats[s->world.units.type[i]];
         }
     }
 
+    Slots_Rebuild(s);
+    Game_SnapshotState(s);
+
     s->selection.primary_unit_idx = -1;
-    for (int i = 0; i < MAX_UNITS; i++) s->selection.unit_selected[i] = false;
+    Bits_ClearAll(s->selection.unit_selected, MAX_UNITS);
     s->selection.box_active = false;
     s->input.pending_input_type = INPUT_NONE;
 
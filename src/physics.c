@@ -3,30 +3,46 @@
 #include "game.h"
 #include "particles.h"
 #include "utils.h"
+#include "rng.h"
+#include "spatial.h"
+#include "jobs.h"
+#include "commands.h"
 #include <math.h>
 #include <stdlib.h>
+#if PHYSICS_SIMD && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define PHYSICS_SSE2 1
+#endif
 
 void Physics_UpdateAsteroids(AppState *s, float dt) {
-  for (int i = 0; i < MAX_ASTEROIDS; i++) {
-    if (!s->world.asteroids.active[i])
+  for (int k = 0; k < s->world.slots.asteroids.live_count; k++) {
+    int i = s->world.slots.asteroids.live[k];
+    // Motion is linear, so one banked step lands where the short ones would have.
+    // Sleepers bank everything and catch up in one step once they wake.
+    float step = s->world.asteroids.drift_dt[i] + dt;
+    if (s->world.asteroids.tier[i] == SIM_TIER_SLEEP || (s->world.asteroids.tier[i] == SIM_TIER_DRIFT && step < SIM_DRIFT_STEP)) {
+      s->world.asteroids.drift_dt[i] = step;
       continue;
-    s->world.asteroids.pos[i].x += s->world.asteroids.velocity[i].x * dt;
-    s->world.asteroids.pos[i].y += s->world.asteroids.velocity[i].y * dt;
-    s->world.asteroids.rotation[i] += s->world.asteroids.rot_speed[i] * dt;
+    }
+    s->world.asteroids.drift_dt[i] = 0.0f;
+    s->world.asteroids.pos[i].x += s->world.asteroids.velocity[i].x * step;
+    s->world.asteroids.pos[i].y += s->world.asteroids.velocity[i].y * step;
+    s->world.asteroids.rotation[i] += s->world.asteroids.rot_speed[i] * step;
   }
 }
 
 void Physics_UpdateResources(AppState *s, float dt) {
-  for (int i = 0; i < MAX_RESOURCES; i++) {
-    if (!s->world.resources.active[i])
-      continue;
+  for (int k = 0; k < s->world.slots.resources.live_count; k++) {
+    int i = s->world.slots.resources.live[k];
     s->world.resources.pos[i].x += s->world.resources.velocity[i].x * dt;
     s->world.resources.pos[i].y += s->world.resources.velocity[i].y * dt;
     s->world.resources.rotation[i] += s->world.resources.rot_speed[i] * dt;
   }
 }
 
-static float SolveCollision(Vec2 *p1, Vec2 *v1, float r1, Vec2 *p2, Vec2 *v2, float r2, bool is_unit1, bool is_unit2) {
+// Pushes the two circles apart and exchanges velocity along the normal. Touches only the
+// four vectors passed in, so disjoint pairs can be solved on different threads.
+static float SolveCollision(Vec2 *p1, Vec2 *v1, float r1, Vec2 *p2, Vec2 *v2, float r2, bool is_unit1, bool is_unit2, bool *touching) {
     float dx = p2->x - p1->x;
     float dy = p2->y - p1->y;
     float dist_sq = dx * dx + dy * dy;
@@ -36,7 +52,8 @@ static float SolveCollision(Vec2 *p1, Vec2 *v1, float r1, Vec2 *p2, Vec2 *v2, fl
     float effective_r2 = is_unit2 ? r2 : (r2 * ASTEROID_HITBOX_MULT);
     float r_sum = effective_r1 + effective_r2;
 
-    if (dist_sq < r_sum * r_sum) {
+    *touching = dist_sq < r_sum * r_sum;
+    if (*touching) {
         float dist = sqrtf(dist_sq);
         if (dist < 0.001f) return 0;
         float nx = dx / dist, ny = dy / dist;
@@ -64,112 +81,449 @@ static float SolveCollision(Vec2 *p1, Vec2 *v1, float r1, Vec2 *p2, Vec2 *v2, fl
     return 0;
 }
 
-void Physics_AreaDamage(AppState *s, Vec2 pos, float range, float damage, int exclude_unit_idx) {
-    float range_sq = range * range;
-    // Damage units
-    for (int i = 0; i < MAX_UNITS; i++) {
-        if (!s->world.units.active[i] || i == exclude_unit_idx) continue;
-        float dsq = Vector_DistanceSq(pos, s->world.units.pos[i]);
-        if (dsq < range_sq) {
-            float dist = sqrtf(dsq);
-            float falloff = 1.0f - (dist / range);
-            s->world.units.health[i] -= damage * falloff;
-        }
-    }
-    // Damage asteroids
-    for (int i = 0; i < MAX_ASTEROIDS; i++) {
-        if (!s->world.asteroids.active[i]) continue;
-        float dsq = Vector_DistanceSq(pos, s->world.asteroids.pos[i]);
-        if (dsq < range_sq) {
-            float dist = sqrtf(dsq);
-            float falloff = 1.0f - (dist / range);
-            s->world.asteroids.health[i] -= damage * falloff * 0.5f;
+static void CountPair(AppState *s, bool touching) {
+    s->counters.collision_pairs_tested++;
+    if (touching) s->counters.collision_pairs_resolved++;
+}
+
+void Physics_ApplyBlasts(AppState *s, const AreaBlast *blasts, int count) {
+    if (count == 0) return;
+    BlastState *acc = &s->world.blast;
+    int touched_count = 0;
+    int ids[SPATIAL_MAX_IDS];
+    Vec2 cam = {s->camera.pos.x + 640/s->camera.zoom, s->camera.pos.y + 360/s->camera.zoom};
+    float shake = 0.0f;
+
+    for (int b = 0; b < count; b++) {
+        const AreaBlast *bl = &blasts[b];
+        float range_sq = bl->range * bl->range;
+        int n = Spatial_QueryRadius(s, &s->world.grid, bl->pos, bl->range, SPATIAL_MASK(SPATIAL_ASTEROID) | SPATIAL_MASK(SPATIAL_UNIT), ids, SPATIAL_MAX_IDS);
+        for (int k = 0; k < n; k++) {
+            int i = Spatial_Index(ids[k]);
+            bool is_unit = Spatial_Kind(ids[k]) == SPATIAL_UNIT;
+            if (i == (is_unit ? bl->exclude_unit_idx : bl->exclude_asteroid_idx)) continue;
+            float dsq = Vector_DistanceSq(bl->pos, is_unit ? s->world.units.pos[i] : s->world.asteroids.pos[i]);
+            if (dsq >= range_sq) continue;
+            float falloff = bl->falloff ? 1.0f - (sqrtf(dsq) / bl->range) : 1.0f;
+            float d = bl->damage * falloff * (is_unit ? bl->unit_mult : bl->asteroid_mult);
+            if (!acc->hit[ids[k]]) {
+                acc->hit[ids[k]] = true;
+                acc->sum[ids[k]] = 0.0f;
+                acc->touched[touched_count++] = ids[k];
+            }
+            acc->sum[ids[k]] += d;
         }
+        // Camera Shake, strongest blast of the batch
+        if (!bl->shake) continue;
+        float dist_to_cam = Vector_Distance(bl->pos, cam);
+        shake = fmaxf(shake, (bl->damage / 1000.0f) * (1.0f - fminf(1.0f, dist_to_cam / 5000.0f)));
     }
 
-    // Camera Shake
-    float dist_to_cam = Vector_Distance(pos, (Vec2){s->camera.pos.x + 640/s->camera.zoom, s->camera.pos.y + 360/s->camera.zoom});
-    float shake = (damage / 1000.0f) * (1.0f - fminf(1.0f, dist_to_cam / 5000.0f));
+    for (int k = 0; k < touched_count; k++) {
+        int id = acc->touched[k], i = Spatial_Index(id);
+        if (Spatial_Kind(id) == SPATIAL_UNIT) s->world.units.health[i] -= acc->sum[id];
+        else s->world.asteroids.health[i] -= acc->sum[id];
+        acc->hit[id] = false;
+    }
     if (shake > s->camera.shake_intensity) s->camera.shake_intensity = fminf(shake, 100.0f);
 }
 
-void Physics_HandleCollisions(AppState *s, float dt) {
-  (void)dt;
-  // 1. Asteroid vs Asteroid
+// Unit rams above this impulse destroy the asteroid
+static bool RamsAsteroid(const CollisionEvent *e) { return e->type == COLLISION_UNIT_ASTEROID && e->magnitude > 10.0f; }
+
+// Health from one contact's impulse; asteroid splits are only flagged here
+static void ApplyEventDamage(AppState *s, const CollisionEvent *e) {
+  if (e->type == COLLISION_ASTEROID_ASTEROID && e->magnitude > ASTEROID_COLLISION_SPLIT_THRESHOLD) {
+      // Both asteroids take damage
+      s->world.asteroids.health[e->a] -= e->magnitude * 0.1f;
+      s->world.asteroids.health[e->b] -= e->magnitude * 0.1f;
+      s->world.contacts.split[e->a] = true;
+      s->world.contacts.split[e->b] = true;
+  } else if (RamsAsteroid(e)) { // Lower threshold for explosion
+      s->world.units.health[e->a] -= e->magnitude * 0.5f; // Units take more damage from collisions
+  } else if (e->type == COLLISION_UNIT_RESOURCE && e->magnitude > 50.0f) {
+      s->world.units.health[e->a] -= e->magnitude * 0.02f;
+  }
+}
+
+void Physics_EmitEvent(AppState *s, CollisionEventType type, int a, int b, Vec2 point, float magnitude, int tex_idx) {
+  CollisionEvents *e = &s->world.collision_events;
+  CollisionEvent ev = {point, magnitude, (Sint16)a, (Sint16)b, (Uint8)type, (Uint8)tex_idx};
+  if (e->count < COLLISION_EVENT_CAP) {
+    e->events[e->count++] = ev;
+    return;
+  }
+  // Only the serial overflow pass gets here. A dropped contact still deals its damage now; it only loses its VFX.
+  e->dropped++;
+  ApplyEventDamage(s, &ev);
+  if (RamsAsteroid(&ev)) Commands_DestroyAsteroid(s, b, true);
+}
+
+// Contact point on the line between the centres, split by radius
+static Vec2 ContactPoint(Vec2 p1, float r1, Vec2 p2, float r2) {
+  float t = r1 / (r1 + r2);
+  return (Vec2){p1.x + (p2.x - p1.x) * t, p1.y + (p2.y - p1.y) * t};
+}
+
+static void EmitContact(AppState *s, CollisionEventType type, int a, Vec2 pa, float ra, int b, Vec2 pb, float rb, float imp) {
+  Physics_EmitEvent(s, type, a, b, ContactPoint(pa, ra, pb, rb), imp, 0);
+}
+
+// Writes only asteroids i and j, so it is safe inside a contact batch
+static bool SolveAsteroidPair(AppState *s, int i, int j, float *imp) {
+      bool touching;
+      *imp = SolveCollision(&s->world.asteroids.pos[i], &s->world.asteroids.velocity[i], s->world.asteroids.radius[i],
+                     &s->world.asteroids.pos[j], &s->world.asteroids.velocity[j], s->world.asteroids.radius[j], false, false, &touching);
+      return touching;
+}
+
+// Serial callers solve, count and emit in one go
+static void ResolveAsteroidPair(AppState *s, int i, int j) {
+  float imp;
+  bool touching = SolveAsteroidPair(s, i, j, &imp);
+  CountPair(s, touching);
+  const AsteroidPool *a = &s->world.asteroids;
+  if (touching) EmitContact(s, COLLISION_ASTEROID_ASTEROID, i, a->pos[i], a->radius[i], j, a->pos[j], a->radius[j], imp);
+}
+
+#ifdef PHYSICS_SSE2
+// SolveCollision for four disjoint asteroid pairs at once. Every lane repeats the scalar
+// operations in the same order, so results match the reference bit for bit.
+static void SolveAsteroidPairs4(AppState *s, const Uint32 *pairs, Uint8 *touching, float *impulses) {
+  AsteroidPool *a = &s->world.asteroids;
+  int ia[4], ib[4];
+  float p1x[4], p1y[4], v1x[4], v1y[4], r1[4], p2x[4], p2y[4], v2x[4], v2y[4], r2[4];
+  for (int l = 0; l < 4; l++) {
+    ia[l] = (int)(pairs[l] >> 16);
+    ib[l] = (int)(pairs[l] & 0xFFFF);
+    p1x[l] = a->pos[ia[l]].x; p1y[l] = a->pos[ia[l]].y;
+    v1x[l] = a->velocity[ia[l]].x; v1y[l] = a->velocity[ia[l]].y;
+    r1[l] = a->radius[ia[l]];
+    p2x[l] = a->pos[ib[l]].x; p2y[l] = a->pos[ib[l]].y;
+    v2x[l] = a->velocity[ib[l]].x; v2y[l] = a->velocity[ib[l]].y;
+    r2[l] = a->radius[ib[l]];
+  }
+  __m128 P1x = _mm_loadu_ps(p1x), P1y = _mm_loadu_ps(p1y), V1x = _mm_loadu_ps(v1x), V1y = _mm_loadu_ps(v1y), M1 = _mm_loadu_ps(r1);
+  __m128 P2x = _mm_loadu_ps(p2x), P2y = _mm_loadu_ps(p2y), V2x = _mm_loadu_ps(v2x), V2y = _mm_loadu_ps(v2y), M2 = _mm_loadu_ps(r2);
+
+  __m128 dx = _mm_sub_ps(P2x, P1x);
+  __m128 dy = _mm_sub_ps(P2y, P1y);
+  __m128 dist_sq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+  __m128 hitbox = _mm_set1_ps(ASTEROID_HITBOX_MULT);
+  __m128 r_sum = _mm_add_ps(_mm_mul_ps(M1, hitbox), _mm_mul_ps(M2, hitbox));
+  __m128 touch = _mm_cmplt_ps(dist_sq, _mm_mul_ps(r_sum, r_sum));
+  int touch_bits = _mm_movemask_ps(touch);
+  for (int l = 0; l < 4; l++) {
+    touching[l] = (Uint8)((touch_bits >> l) & 1);
+    impulses[l] = 0.0f;
+  }
+
+  __m128 dist = _mm_sqrt_ps(dist_sq);
+  int apply_bits = _mm_movemask_ps(_mm_and_ps(touch, _mm_cmpge_ps(dist, _mm_set1_ps(0.001f))));
+  if (!apply_bits) return;
+
+  // Lanes outside apply_bits may hold inf or NaN; they are never written back
+  __m128 half = _mm_set1_ps(0.5f);
+  __m128 nx = _mm_div_ps(dx, dist), ny = _mm_div_ps(dy, dist);
+  __m128 overlap = _mm_sub_ps(r_sum, dist);
+  __m128 push_x = _mm_mul_ps(_mm_mul_ps(nx, overlap), half);
+  __m128 push_y = _mm_mul_ps(_mm_mul_ps(ny, overlap), half);
+  _mm_storeu_ps(p1x, _mm_sub_ps(P1x, push_x));
+  _mm_storeu_ps(p1y, _mm_sub_ps(P1y, push_y));
+  _mm_storeu_ps(p2x, _mm_add_ps(P2x, push_x));
+  _mm_storeu_ps(p2y, _mm_add_ps(P2y, push_y));
+
+  __m128 v1n = _mm_add_ps(_mm_mul_ps(V1x, nx), _mm_mul_ps(V1y, ny));
+  __m128 v2n = _mm_add_ps(_mm_mul_ps(V2x, nx), _mm_mul_ps(V2y, ny));
+  __m128 mass = _mm_add_ps(M1, M2);
+  __m128 impulse = _mm_div_ps(_mm_mul_ps(_mm_set1_ps(2.0f), _mm_sub_ps(v1n, v2n)), mass);
+  __m128 i2 = _mm_mul_ps(impulse, M2), i1 = _mm_mul_ps(impulse, M1);
+  _mm_storeu_ps(v1x, _mm_sub_ps(V1x, _mm_mul_ps(i2, nx)));
+  _mm_storeu_ps(v1y, _mm_sub_ps(V1y, _mm_mul_ps(i2, ny)));
+  _mm_storeu_ps(v2x, _mm_add_ps(V2x, _mm_mul_ps(i1, nx)));
+  _mm_storeu_ps(v2y, _mm_add_ps(V2y, _mm_mul_ps(i1, ny)));
+  float imp[4];
+  _mm_storeu_ps(imp, _mm_mul_ps(impulse, mass));
+
+  for (int l = 0; l < 4; l++) {
+    if (!((apply_bits >> l) & 1)) continue;
+    a->pos[ia[l]] = (Vec2){p1x[l], p1y[l]};
+    a->velocity[ia[l]] = (Vec2){v1x[l], v1y[l]};
+    a->pos[ib[l]] = (Vec2){p2x[l], p2y[l]};
+    a->velocity[ib[l]] = (Vec2){v2x[l], v2y[l]};
+    impulses[l] = fabsf(imp[l]);
+  }
+}
+#endif
+
+// Damage consumer: health from contact impulses, then splits and rammed asteroids as commands.
+// Splits are queued lowest index first so the rng draws are reproducible, and ahead of destruction.
+static void ApplyContactDamage(AppState *s, int first, int last) {
+  const CollisionEvent *ev = s->world.collision_events.events;
+  for (int k = first; k < last; k++) ApplyEventDamage(s, &ev[k]);
+  for (int idx = 0; idx < MAX_ASTEROIDS; idx++) {
+      if (!s->world.contacts.split[idx]) continue;
+      s->world.contacts.split[idx] = false;
+      Commands_SplitAsteroid(s, idx);
+  }
+  // Asteroid explodes on unit collision
+  for (int k = first; k < last; k++)
+      if (RamsAsteroid(&ev[k])) Commands_DestroyAsteroid(s, ev[k].b, true);
+}
+
+// Gather job: pairs (i, j > i) whose hitbox bounds overlap, one run per asteroid
+static void GatherContacts(void *ctx, int begin, int end) {
+  AppState *s = (AppState *)ctx;
+  ContactState *c = &s->world.contacts;
+  int ids[SPATIAL_MAX_IDS];
+  Uint32 run[SPATIAL_MAX_IDS];
+  for (int i = begin; i < end; i++) {
+    c->run_count[i] = 0;
+    if (!Spatial_AsteroidCollides(&s->world.asteroids, i)) continue;
+    Vec2 p = s->world.asteroids.pos[i];
+    float r = s->world.asteroids.radius[i] * ASTEROID_HITBOX_MULT;
+    int n = Spatial_QueryAABB(s, &s->world.grid, p.x - r, p.y - r, p.x + r, p.y + r, SPATIAL_MASK(SPATIAL_ASTEROID), ids, SPATIAL_MAX_IDS);
+    int len = 0;
+    for (int k = 0; k < n; k++) {
+      int j = ids[k];
+      if (j > i && s->world.asteroids.tier[j] == SIM_TIER_FULL && Spatial_BoundsOverlap(p, r, s->world.asteroids.pos[j], s->world.asteroids.radius[j] * ASTEROID_HITBOX_MULT))
+        run[len++] = ((Uint32)i << 16) | (Uint32)j;
+    }
+    if (len == 0) continue;
+    int start = SDL_AddAtomicInt(&c->gathered_count, len);
+    if (start + len > CONTACT_MAX_PAIRS) continue; // The caller sees the overflow in gathered_count
+    SDL_memcpy(&c->gathered[start], run, sizeof(Uint32) * len);
+    c->run_start[i] = start;
+    c->run_count[i] = len;
+  }
+}
+
+// Each pair lands one batch after the latest batch of either of its asteroids. Every asteroid therefore
+// meets its contacts in the same order as a serial pass over the ordered list, whatever the thread count.
+static void BuildBatches(ContactState *c, const Uint32 *ordered, int n) {
+  SDL_memset(c->last_batch, 0, sizeof(c->last_batch));
+  c->pair_count = n;
+  c->batch_count = 0;
+  for (int p = 0; p < n; p++) {
+    int i = (int)(ordered[p] >> 16), j = (int)(ordered[p] & 0xFFFF);
+    Uint16 b = (Uint16)(SDL_max(c->last_batch[i], c->last_batch[j]) + 1);
+    c->pair_batch[p] = c->last_batch[i] = c->last_batch[j] = b;
+    if (b > c->batch_count) c->batch_count = b;
+  }
+  // Stable counting sort by batch keeps each batch in ascending pair order
+  SDL_memset(c->batch_start, 0, sizeof(int) * (c->batch_count + 1));
+  for (int p = 0; p < n; p++) c->batch_start[c->pair_batch[p]]++;
+  for (int b = 0, sum = 0; b <= c->batch_count; b++) {
+    int count = c->batch_start[b];
+    c->batch_start[b] = sum;
+    sum += count;
+  }
+  // The fill advances each start to the next batch's, so batch b ends up spanning [start[b - 1], start[b])
+  for (int p = 0; p < n; p++) c->batched[c->batch_start[c->pair_batch[p]]++] = ordered[p];
+}
+
+typedef struct {
+  AppState *s;
+  int base;
+} SolveJob;
+
+static void SolveContacts(void *ctx, int begin, int end) {
+  const SolveJob *job = (const SolveJob *)ctx;
+  ContactState *c = &job->s->world.contacts;
+  int p = job->base + begin;
+#ifdef PHYSICS_SSE2
+  // Pairs within a batch never share an asteroid, so any four can go through the kernel together
+  for (; p + 4 <= job->base + end; p += 4) SolveAsteroidPairs4(job->s, &c->batched[p], &c->touching[p], &c->impulse[p]);
+#endif
+  for (; p < job->base + end; p++)
+    c->touching[p] = SolveAsteroidPair(job->s, (int)(c->batched[p] >> 16), (int)(c->batched[p] & 0xFFFF), &c->impulse[p]);
+}
+
+// Serial pass for the rare tick whose contacts overflow CONTACT_MAX_PAIRS
+static void SolveAsteroidsSerial(AppState *s) {
+  int ids[SPATIAL_MAX_IDS];
   for (int i = 0; i < MAX_ASTEROIDS; i++) {
-    if (!s->world.asteroids.active[i]) continue;
-    for (int j = i + 1; j < MAX_ASTEROIDS; j++) {
-      if (!s->world.asteroids.active[j]) continue;
-      float imp = SolveCollision(&s->world.asteroids.pos[i], &s->world.asteroids.velocity[i], s->world.asteroids.radius[i],
-                     &s->world.asteroids.pos[j], &s->world.asteroids.velocity[j], s->world.asteroids.radius[j], false, false);
-      
-      if (imp > ASTEROID_COLLISION_SPLIT_THRESHOLD) {
-          // Both asteroids take damage
-          s->world.asteroids.health[i] -= imp * 0.1f;
-          s->world.asteroids.health[j] -= imp * 0.1f;
-          
-          // Check for splitting
-          int targets[2] = {i, j};
-          for(int k=0; k<2; k++) {
-              int idx = targets[k];
-              if (s->world.asteroids.radius[idx] > ASTEROID_SPLIT_MIN_RADIUS) {
-                  float old_rad = s->world.asteroids.radius[idx];
-                  float new_rad = old_rad * ASTEROID_SPLIT_EXPONENT;
-                  Vec2 pos = s->world.asteroids.pos[idx];
-                  Vec2 vel = s->world.asteroids.velocity[idx];
-                  
-                  // Deactivate old
-                  s->world.asteroids.active[idx] = false;
-                  s->world.asteroid_count--;
-                  
-                  // Explosion VFX for splitting
-                  Particles_SpawnExplosion(s, pos, 20, old_rad / 500.0f, EXPLOSION_COLLISION, s->world.asteroids.tex_idx[idx]);
-
-                  // Spawn two smaller fragments
-                  for(int f=0; f<2; f++) {
-                      float angle = ((float)rand()/(float)RAND_MAX) * 2.0f * 3.14159f;
-                      Vec2 off = {cosf(angle) * new_rad, sinf(angle) * new_rad};
-                      Vec2 f_pos = {pos.x + off.x, pos.y + off.y};
-                      Vec2 f_vel = {vel.x + off.x * 0.5f, vel.y + off.y * 0.5f};
-                      SpawnAsteroid(s, f_pos, Vector_Normalize(f_vel), new_rad);
-                  }
-              }
-          }
+    if (!Spatial_AsteroidCollides(&s->world.asteroids, i)) continue;
+    Vec2 p = s->world.asteroids.pos[i];
+    float r = s->world.asteroids.radius[i] * ASTEROID_HITBOX_MULT;
+    int n = Spatial_QueryAABB(s, &s->world.grid, p.x - r, p.y - r, p.x + r, p.y + r, SPATIAL_MASK(SPATIAL_ASTEROID), ids, SPATIAL_MAX_IDS);
+    for (int k = 0; k < n; k++) {
+      int j = ids[k];
+      if (j > i && s->world.asteroids.tier[j] == SIM_TIER_FULL && Spatial_BoundsOverlap(p, r, s->world.asteroids.pos[j], s->world.asteroids.radius[j] * ASTEROID_HITBOX_MULT))
+        ResolveAsteroidPair(s, i, j);
+    }
+  }
+}
+
+static void HandleAsteroidContacts(AppState *s) {
+  ContactState *c = &s->world.contacts;
+  const Uint32 *ordered = NULL;
+  int n = -1;
+  if (s->world.broadphase == BROADPHASE_SAP) n = Spatial_SweepPairs(s, &s->world.sweep);
+  if (n >= 0) {
+    ordered = s->world.sweep.pairs;
+  } else {
+    SDL_SetAtomicInt(&c->gathered_count, 0);
+    Jobs_ParallelFor(&s->jobs, MAX_ASTEROIDS, CONTACT_GATHER_GRAIN, GatherContacts, s);
+    n = SDL_GetAtomicInt(&c->gathered_count);
+    if (n <= CONTACT_MAX_PAIRS) {
+      // Concatenating the runs by asteroid restores (i, j) order
+      int k = 0;
+      for (int i = 0; i < MAX_ASTEROIDS; i++) {
+        SDL_memcpy(&c->ordered[k], &c->gathered[c->run_start[i]], sizeof(Uint32) * c->run_count[i]);
+        k += c->run_count[i];
       }
+      ordered = c->ordered;
     }
   }
 
-  // 4. Unit vs Asteroid/Resource
-  for (int i = 0; i < MAX_UNITS; i++) {
-      if (!s->world.units.active[i]) continue;
-      // vs Asteroids
-      for (int j = 0; j < MAX_ASTEROIDS; j++) {
-          if (!s->world.asteroids.active[j]) continue;
+  if (ordered) {
+    BuildBatches(c, ordered, n);
+    for (int b = 1; b <= c->batch_count; b++) {
+      SolveJob job = {s, c->batch_start[b - 1]};
+      Jobs_ParallelFor(&s->jobs, c->batch_start[b] - c->batch_start[b - 1], CONTACT_SOLVE_GRAIN, SolveContacts, &job);
+    }
+    // Emitted serially in batch order, so each asteroid's events keep the order they were solved in
+    const AsteroidPool *a = &s->world.asteroids;
+    for (int p = 0; p < n; p++) {
+      CountPair(s, c->touching[p]);
+      if (!c->touching[p]) continue;
+      int i = (int)(c->batched[p] >> 16), j = (int)(c->batched[p] & 0xFFFF);
+      EmitContact(s, COLLISION_ASTEROID_ASTEROID, i, a->pos[i], a->radius[i], j, a->pos[j], a->radius[j], c->impulse[p]);
+    }
+  } else {
+    SolveAsteroidsSerial(s);
+  }
+}
+
+static void ResolveUnitAsteroid(AppState *s, int i, int j) {
+          bool touching;
           float imp = SolveCollision(&s->world.units.pos[i], &s->world.units.velocity[i], s->world.units.stats[i]->radius,
-                         &s->world.asteroids.pos[j], &s->world.asteroids.velocity[j], s->world.asteroids.radius[j], true, false);
-          if (imp > 10.0f) { // Lower threshold for explosion
-              s->world.units.health[i] -= imp * 0.5f; // Units take more damage from collisions
-              
-              // Asteroid explodes on unit collision
-              float rad = s->world.asteroids.radius[j];
-              Vec2 pos = s->world.asteroids.pos[j];
-              int tex = s->world.asteroids.tex_idx[j];
-              
-              s->world.asteroids.active[j] = false;
-              s->world.asteroid_count--;
-              
-              Particles_SpawnExplosion(s, pos, 40, rad / 200.0f, EXPLOSION_COLLISION, tex);
-              Physics_AreaDamage(s, pos, rad * 2.5f, rad * 50.0f, -1);
-          }
-      }
-      // vs Resources
-      for (int j = 0; j < MAX_RESOURCES; j++) {
-          if (!s->world.resources.active[j]) continue;
+                         &s->world.asteroids.pos[j], &s->world.asteroids.velocity[j], s->world.asteroids.radius[j], true, false, &touching);
+          CountPair(s, touching);
+          if (touching)
+              EmitContact(s, COLLISION_UNIT_ASTEROID, i, s->world.units.pos[i], s->world.units.stats[i]->radius, j, s->world.asteroids.pos[j], s->world.asteroids.radius[j], imp);
+}
+
+static void ResolveUnitResource(AppState *s, int i, int j) {
+          bool touching;
           float imp = SolveCollision(&s->world.units.pos[i], &s->world.units.velocity[i], s->world.units.stats[i]->radius,
-                         &s->world.resources.pos[j], &s->world.resources.velocity[j], s->world.resources.radius[j], true, false);
-          if (imp > 50.0f) {
-              s->world.units.health[i] -= imp * 0.02f;
-          }
+                         &s->world.resources.pos[j], &s->world.resources.velocity[j], s->world.resources.radius[j], true, false, &touching);
+          CountPair(s, touching);
+          if (touching)
+              EmitContact(s, COLLISION_UNIT_RESOURCE, i, s->world.units.pos[i], s->world.units.stats[i]->radius, j, s->world.resources.pos[j], s->world.resources.radius[j], imp);
+}
+
+// Tick fraction of first contact for two circles moving linearly from a0 and b0 by da and db,
+// or -1 unless they pass through each other without touching at either end of the tick.
+// Contact is taken just inside r_sum: at exactly r_sum rounding leaves about two thirds of hits
+// reading as apart, and at closest approach the relative motion is tangential, so no impulse.
+static float SweptFirstContactT(Vec2 a0, Vec2 da, Vec2 b0, Vec2 db, float r_sum) {
+  float px = b0.x - a0.x, py = b0.y - a0.y;
+  float vx = db.x - da.x, vy = db.y - da.y;
+  float a = vx * vx + vy * vy;
+  float half_b = px * vx + py * vy;
+  float c = px * px + py * py - r_sum * r_sum;
+  if (c <= 0.0f || half_b >= 0.0f || a < 1e-6f) return -1.0f; // Touching at the start, or separating
+  if (a + 2.0f * half_b + c < 0.0f) return -1.0f; // Touching at the end, the discrete pass has it
+  float r_hit = r_sum * SWEPT_CONTACT_DEPTH;
+  float disc = half_b * half_b - a * (px * px + py * py - r_hit * r_hit);
+  if (disc <= 0.0f) return -1.0f; // Closest approach stays outside the contact distance
+  float t0 = (-half_b - sqrtf(disc)) / a;
+  return t0 < 1.0f ? t0 : -1.0f;
+}
+
+static Vec2 Lerp(Vec2 a, Vec2 d, float t) { return (Vec2){a.x + d.x * t, a.y + d.y * t}; }
+
+// Asteroids moving further than their hitbox radius in a tick can pass straight through a body
+// between two discrete tests. Each one is rewound to first contact of its earliest pass-through, resolved there by
+// the regular solvers and carried on for the rest of the tick. At the default tick rate no
+// asteroid is this fast, so the pass returns after one scan.
+static void SweepFastAsteroids(AppState *s, float dt) {
+  AsteroidPool *a = &s->world.asteroids;
+  ContactState *c = &s->world.contacts;
+  float max_disp = 0.0f;
+  bool any_fast = false;
+  for (int k = 0; k < s->world.slots.asteroids.live_count; k++) {
+    int i = s->world.slots.asteroids.live[k];
+    if (!Spatial_AsteroidCollides(a, i)) continue;
+    float disp = Vector_Distance(a->prev_pos[i], a->pos[i]);
+    max_disp = fmaxf(max_disp, disp);
+    if (disp > a->radius[i] * ASTEROID_HITBOX_MULT) any_fast = true;
+  }
+  if (!any_fast) return;
+
+  SDL_memset(c->swept, 0, sizeof(c->swept));
+  int ids[SPATIAL_MAX_IDS];
+  for (int i = 0; i < MAX_ASTEROIDS; i++) {
+    if (!Spatial_AsteroidCollides(a, i) || c->swept[i]) continue;
+    float r = a->radius[i] * ASTEROID_HITBOX_MULT;
+    Vec2 a0 = a->prev_pos[i], a1 = a->pos[i];
+    Vec2 da = {a1.x - a0.x, a1.y - a0.y};
+    if (Vector_Length(da) <= r) continue;
+
+    // The grid holds end positions, so pad by the furthest any other asteroid moved
+    float pad = r + max_disp;
+    int n = Spatial_QueryAABB(s, &s->world.grid, fminf(a0.x, a1.x) - pad, fminf(a0.y, a1.y) - pad, fmaxf(a0.x, a1.x) + pad, fmaxf(a0.y, a1.y) + pad,
+                              SPATIAL_MASK(SPATIAL_ASTEROID) | SPATIAL_MASK(SPATIAL_UNIT), ids, SPATIAL_MAX_IDS);
+    int hit = -1;
+    float hit_t = 1.0f;
+    for (int k = 0; k < n; k++) {
+      int j = Spatial_Index(ids[k]);
+      float t;
+      if (Spatial_Kind(ids[k]) == SPATIAL_ASTEROID) {
+        if (j == i || !Spatial_AsteroidCollides(a, j) || c->swept[j]) continue;
+        Vec2 db = {a->pos[j].x - a->prev_pos[j].x, a->pos[j].y - a->prev_pos[j].y};
+        t = SweptFirstContactT(a0, da, a->prev_pos[j], db, r + a->radius[j] * ASTEROID_HITBOX_MULT);
+      } else {
+        // Units move after collisions, so they sit still for this tick's sweep
+        if (!Bits_Test(s->world.units.active, j)) continue;
+        t = SweptFirstContactT(a0, da, s->world.units.pos[j], (Vec2){0.0f, 0.0f}, r + s->world.units.stats[j]->radius);
       }
+      if (t >= 0.0f && t < hit_t) { hit_t = t; hit = ids[k]; } // Ids ascend, so ties keep the lowest
+    }
+    if (hit == -1) continue;
+
+    int j = Spatial_Index(hit);
+    float rest = dt * (1.0f - hit_t);
+    a->pos[i] = Lerp(a0, da, hit_t);
+    c->swept[i] = true;
+    if (Spatial_Kind(hit) == SPATIAL_ASTEROID) {
+      a->pos[j] = Lerp(a->prev_pos[j], (Vec2){a->pos[j].x - a->prev_pos[j].x, a->pos[j].y - a->prev_pos[j].y}, hit_t);
+      c->swept[j] = true;
+      ResolveAsteroidPair(s, SDL_min(i, j), SDL_max(i, j));
+      a->pos[j] = Lerp(a->pos[j], a->velocity[j], rest);
+    } else {
+      ResolveUnitAsteroid(s, j, i);
+    }
+    a->pos[i] = Lerp(a->pos[i], a->velocity[i], rest);
   }
-}
\ No newline at end of file
+}
+
+// Asteroid pairs are solved in conflict-free batches across the job pool; unit contacts stay serial.
+// The solvers only move bodies and emit contact events; damage and structural changes follow as their own passes.
+void Physics_HandleCollisions(AppState *s, float dt) {
+  const SpatialGrid *g = &s->world.grid;
+  int ids[SPATIAL_MAX_IDS];
+  int first_event = s->world.collision_events.count;
+
+  // 1. Asteroid vs Asteroid, swept first for the fast ones
+  SweepFastAsteroids(s, dt);
+  HandleAsteroidContacts(s);
+
+  // 4. Unit vs Asteroid/Resource
+  BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) {
+      Vec2 p = s->world.units.pos[i];
+      float r = s->world.units.stats[i]->radius;
+      int n = Spatial_QueryAABB(s, g, p.x - r, p.y - r, p.x + r, p.y + r, SPATIAL_MASK(SPATIAL_ASTEROID) | SPATIAL_MASK(SPATIAL_RESOURCE), ids, SPATIAL_MAX_IDS);
+      // Ids sort asteroids before resources, matching the linear order
+      for (int k = 0; k < n; k++) {
+          int j = Spatial_Index(ids[k]);
+          if (Spatial_Kind(ids[k]) == SPATIAL_ASTEROID) { if (Bits_Test(s->world.asteroids.active, j)) ResolveUnitAsteroid(s, i, j); }
+          else if (Bits_Test(s->world.resources.active, j)) ResolveUnitResource(s, i, j);
+      }
+  }
+
+  ApplyContactDamage(s, first_event, s->world.collision_events.count);
+  Commands_Flush(s);
+}
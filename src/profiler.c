@@ -0,0 +1,73 @@
+#include "profiler.h"
+#include "trace.h"
+
+static const ProfileZoneInfo zone_table[PROF_ZONE_COUNT] = {
+    [PROF_FRAME] = {"frame", PROF_ZONE_COUNT, {200, 200, 200, 255}},
+    [PROF_TARGETING] = {"targeting", PROF_FRAME, {255, 140, 200, 255}},
+    [PROF_UPDATE] = {"update", PROF_FRAME, {120, 200, 255, 255}},
+    [PROF_UPDATE_MISC] = {"misc", PROF_UPDATE, {90, 90, 120, 255}},
+    [PROF_PRODUCTION] = {"production", PROF_UPDATE, {150, 120, 60, 255}},
+    [PROF_HOVER] = {"hover", PROF_UPDATE, {110, 110, 160, 255}},
+    [PROF_SPAWNING] = {"spawning", PROF_UPDATE, {60, 200, 120, 255}},
+    [PROF_INTEGRATE] = {"integrate", PROF_UPDATE, {40, 140, 200, 255}},
+    [PROF_COLLISIONS] = {"collisions", PROF_UPDATE, {255, 70, 70, 255}},
+    [PROF_UNITS] = {"units", PROF_UPDATE, {255, 200, 60, 255}},
+    [PROF_UNIT_MOVEMENT] = {"unit_movement", PROF_UNITS, {255, 220, 120, 255}},
+    [PROF_ABILITIES] = {"abilities", PROF_UNITS, {230, 160, 40, 255}},
+    [PROF_PARTICLES] = {"particles", PROF_UPDATE, {200, 90, 255, 255}},
+    [PROF_RENDER] = {"render", PROF_FRAME, {120, 255, 160, 255}},
+    [PROF_RENDER_BACKGROUND] = {"background", PROF_RENDER, {40, 60, 120, 255}},
+    [PROF_RENDER_PARALLAX] = {"parallax", PROF_RENDER, {70, 110, 220, 255}},
+    [PROF_RENDER_ASTEROIDS] = {"draw_asteroids", PROF_RENDER, {170, 130, 100, 255}},
+    [PROF_RENDER_CRYSTALS] = {"draw_crystals", PROF_RENDER, {80, 255, 200, 255}},
+    [PROF_RENDER_UNITS] = {"draw_units", PROF_RENDER, {255, 255, 120, 255}},
+    [PROF_RENDER_PARTICLES] = {"draw_particles", PROF_RENDER, {255, 120, 220, 255}},
+    [PROF_RENDER_HUD] = {"hud", PROF_RENDER, {180, 180, 180, 255}},
+    [PROF_RENDER_PRESENT] = {"present", PROF_RENDER, {100, 100, 100, 255}},
+};
+
+void Profiler_BeginFrame(AppState *s) {
+  SDL_memset(s->profiler.zone_ticks, 0, sizeof(s->profiler.zone_ticks));
+  Profiler_Begin(s, PROF_FRAME);
+}
+
+void Profiler_EndFrame(AppState *s) {
+  Profiler_End(s, PROF_FRAME);
+  float *row = s->profiler.history_ms[s->profiler.history_head];
+  for (int z = 0; z < PROF_ZONE_COUNT; z++) row[z] = (float)Profiler_GetZoneMs(s, z);
+  s->profiler.history_head = (s->profiler.history_head + 1) % PROFILER_HISTORY_FRAMES;
+  if (s->profiler.history_count < PROFILER_HISTORY_FRAMES) s->profiler.history_count++;
+}
+
+// Zones also land in the main thread's trace ring
+void Profiler_Begin(AppState *s, ProfileZone zone) {
+  Trace_Begin(s, TRACE_THREAD_MAIN, zone_table[zone].name);
+  s->profiler.zone_start[zone] = SDL_GetPerformanceCounter();
+}
+
+// Zones may be entered several times per frame (e.g. once per unit or per tick); time accumulates
+void Profiler_End(AppState *s, ProfileZone zone) {
+  s->profiler.zone_ticks[zone] += SDL_GetPerformanceCounter() - s->profiler.zone_start[zone];
+  Trace_End(s, TRACE_THREAD_MAIN, zone_table[zone].name);
+}
+
+double Profiler_GetZoneMs(const AppState *s, ProfileZone zone) {
+  return (double)s->profiler.zone_ticks[zone] * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+// age 0 is the most recently finished frame
+float Profiler_GetHistoryMs(const AppState *s, int age, ProfileZone zone) {
+  if (age < 0 || age >= s->profiler.history_count) return 0.0f;
+  int idx = (s->profiler.history_head - 1 - age + PROFILER_HISTORY_FRAMES) % PROFILER_HISTORY_FRAMES;
+  return s->profiler.history_ms[idx][zone];
+}
+
+const ProfileZoneInfo *Profiler_GetZoneInfo(ProfileZone zone) {
+  return &zone_table[zone];
+}
+
+int Profiler_GetZoneDepth(ProfileZone zone) {
+  int depth = 0;
+  while (zone_table[zone].parent != PROF_ZONE_COUNT) { zone = zone_table[zone].parent; depth++; }
+  return depth;
+}
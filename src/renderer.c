@@ -5,6 +5,11 @@
 #include "ui.h"
 #include "workers.h"
 #include "utils.h"
+#include "profiler.h"
+#include "histogram.h"
+#include "footprint.h"
+#include "spatial.h"
+#include "slots.h"
 #include <math.h>
 #include <stdio.h>
 
@@ -30,6 +35,19 @@ static Vec2 WorldToScreenParallax(Vec2 world_pos, float parallax,
                 (sh / 2.0f) + (world_pos.y - cy) * parallax * zoom};
 }
 
+// Blend between the last two sim ticks; alpha comes from the fixed-step accumulator
+static Vec2 LerpPos(const Vec2 *prev, const Vec2 *cur, int i, float alpha) {
+  return (Vec2){prev[i].x + (cur[i].x - prev[i].x) * alpha, prev[i].y + (cur[i].y - prev[i].y) * alpha};
+}
+
+static Vec2 LerpLanes(const float *prev_x, const float *prev_y, const float *x, const float *y, int i, float alpha) {
+  return (Vec2){prev_x[i] + (x[i] - prev_x[i]) * alpha, prev_y[i] + (y[i] - prev_y[i]) * alpha};
+}
+
+static float LerpAngle(const float *prev, const float *cur, int i, float alpha) {
+  return prev[i] + (cur[i] - prev[i]) * alpha;
+}
+
 static bool IsVisible(float sx, float sy, float radius, int win_w, int win_h) {
   return (sx + radius >= 0 && sx - radius <= win_w && sy + radius >= 0 &&
           sy - radius <= win_h);
@@ -140,20 +158,23 @@ static void SystemLayerFn(SDL_Renderer *r, const AppState *s, const LayerCell *c
   }
 }
 
-static void Renderer_DrawAsteroids(SDL_Renderer *r, const AppState *s, int win_w, int win_h) {
-  for (int i = 0; i < MAX_ASTEROIDS; i++) {
-    if (!s->world.asteroids.active[i]) continue;
-    Vec2 sx_y = WorldToScreenParallax(s->world.asteroids.pos[i], 1.0f, s, win_w, win_h); float rad = s->world.asteroids.radius[i] * s->camera.zoom, v_rad = rad * ASTEROID_VISUAL_SCALE, c_rad = rad * ASTEROID_CORE_SCALE;
+static int Renderer_DrawAsteroids(SDL_Renderer *r, const AppState *s, int win_w, int win_h) {
+  int calls = 0;
+  for (int k = 0; k < s->world.slots.asteroids.live_count; k++) {
+    int i = s->world.slots.asteroids.live[k];
+    Vec2 sx_y = WorldToScreenParallax(LerpPos(s->world.asteroids.prev_pos, s->world.asteroids.pos, i, s->render_alpha), 1.0f, s, win_w, win_h); float rad = s->world.asteroids.radius[i] * s->camera.zoom, v_rad = rad * ASTEROID_VISUAL_SCALE, c_rad = rad * ASTEROID_CORE_SCALE;
     if (!IsVisible(sx_y.x, sx_y.y, v_rad, win_w, win_h)) continue;
-    SDL_RenderTextureRotated(r, s->textures.asteroid_textures[s->world.asteroids.tex_idx[i]], NULL, &(SDL_FRect){sx_y.x - v_rad, sx_y.y - v_rad, v_rad * 2.0f, v_rad * 2.0f}, s->world.asteroids.rotation[i], NULL, SDL_FLIP_NONE);
-    if (s->world.asteroids.targeted[i]) { float hp_pct = s->world.asteroids.health[i] / s->world.asteroids.max_health[i], bw = c_rad * 1.5f; SDL_FRect rct = {sx_y.x - bw/2, sx_y.y + c_rad + 2.0f, bw, 4.0f}; SDL_SetRenderDrawColor(r, 50, 0, 0, 200); SDL_RenderFillRect(r, &rct); rct.w *= hp_pct; SDL_SetRenderDrawColor(r, 255, 50, 50, 255); SDL_RenderFillRect(r, &rct); }
+    SDL_RenderTextureRotated(r, s->textures.asteroid_textures[s->world.asteroids.tex_idx[i]], NULL, &(SDL_FRect){sx_y.x - v_rad, sx_y.y - v_rad, v_rad * 2.0f, v_rad * 2.0f}, LerpAngle(s->world.asteroids.prev_rotation, s->world.asteroids.rotation, i, s->render_alpha), NULL, SDL_FLIP_NONE); calls++;
+    if (Bits_Test(s->world.asteroids.targeted, i)) { calls += 2; float hp_pct = s->world.asteroids.health[i] / s->world.asteroids.max_health[i], bw = c_rad * 1.5f; SDL_FRect rct = {sx_y.x - bw/2, sx_y.y + c_rad + 2.0f, bw, 4.0f}; SDL_SetRenderDrawColor(r, 50, 0, 0, 200); SDL_RenderFillRect(r, &rct); rct.w *= hp_pct; SDL_SetRenderDrawColor(r, 255, 50, 50, 255); SDL_RenderFillRect(r, &rct); }
   }
+  return calls;
 }
 
-static void Renderer_DrawCrystals(SDL_Renderer *r, const AppState *s, int win_w, int win_h) {
-    for (int i = 0; i < MAX_RESOURCES; i++) {
-        if (!s->world.resources.active[i]) continue;
-        Vec2 sp = WorldToScreenParallax(s->world.resources.pos[i], 1.0f, s, win_w, win_h);
+static int Renderer_DrawCrystals(SDL_Renderer *r, const AppState *s, int win_w, int win_h) {
+    int calls = 0;
+    for (int k = 0; k < s->world.slots.resources.live_count; k++) {
+        int i = s->world.slots.resources.live[k];
+        Vec2 sp = WorldToScreenParallax(LerpPos(s->world.resources.prev_pos, s->world.resources.pos, i, s->render_alpha), 1.0f, s, win_w, win_h);
         float rad = s->world.resources.radius[i] * s->camera.zoom;
         float dr = rad * CRYSTAL_VISUAL_SCALE;
         if (!IsVisible(sp.x, sp.y, dr, win_w, win_h)) continue;
@@ -161,8 +182,9 @@ static void Renderer_DrawCrystals(SDL_Renderer *r, const AppState *s, int win_w,
         SDL_SetTextureBlendMode(s->textures.crystal_textures[s->world.resources.tex_idx[i]], SDL_BLENDMODE_BLEND);
         SDL_RenderTextureRotated(r, s->textures.crystal_textures[s->world.resources.tex_idx[i]], NULL,
             &(SDL_FRect){sp.x - dr, sp.y - dr, dr * 2, dr * 2},
-            s->world.resources.rotation[i], NULL, SDL_FLIP_NONE);
-            
+            LerpAngle(s->world.resources.prev_rotation, s->world.resources.rotation, i, s->render_alpha), NULL, SDL_FLIP_NONE);
+        calls++;
+
         // Health Bar
         if (s->world.resources.health[i] < s->world.resources.max_health[i]) {
             float hp_pct = s->world.resources.health[i] / s->world.resources.max_health[i];
@@ -173,8 +195,10 @@ static void Renderer_DrawCrystals(SDL_Renderer *r, const AppState *s, int win_w,
             rct.w *= hp_pct;
             SDL_SetRenderDrawColor(r, 100, 255, 100, 255);
             SDL_RenderFillRect(r, &rct);
+            calls += 2;
         }
     }
+    return calls;
 }
 
 static void DrawGradientCircle(SDL_Renderer *r, float cx, float cy, float radius, SDL_FColor center_color, SDL_FColor edge_color) {
@@ -206,12 +230,14 @@ static void DrawTargetCrosshair(SDL_Renderer *r, float x, float y, float size, S
     SDL_RenderLine(r, x + h, y, x + gap, y);
 }
 
-static void Renderer_DrawParticles(SDL_Renderer *r, const AppState *s, int win_w, int win_h) {
+static int Renderer_DrawParticles(SDL_Renderer *r, const AppState *s, int win_w, int win_h) {
+  int calls = 0;
   SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
-  for (int i = 0; i < MAX_PARTICLES; i++) {
-    if (!s->world.particles.active[i]) continue;
-    Vec2 sx_y = WorldToScreenParallax(s->world.particles.pos[i], 1.0f, s, win_w, win_h); float sz = s->world.particles.size[i] * s->camera.zoom;
+  for (int k = 0; k < s->world.slots.particles.live_count; k++) {
+    int i = s->world.slots.particles.live[k];
+    Vec2 sx_y = WorldToScreenParallax(LerpLanes(s->world.particles.prev_x, s->world.particles.prev_y, s->world.particles.pos_x, s->world.particles.pos_y, i, s->render_alpha), 1.0f, s, win_w, win_h); float sz = s->world.particles.size[i] * s->camera.zoom;
     if (!IsVisible(sx_y.x, sx_y.y, sz, win_w, win_h)) continue;
+    calls++; // Every branch issues at least one draw
     if (s->world.particles.type[i] == PARTICLE_DEBRIS) {
         SDL_SetTextureColorMod(s->textures.debris_textures[s->world.particles.tex_idx[i]], 255, 255, 255);
         float alpha = s->world.particles.life[i] * s->world.particles.life[i];
@@ -244,15 +270,15 @@ static void Renderer_DrawParticles(SDL_Renderer *r, const AppState *s, int win_w
         SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
     }
     else if (s->world.particles.type[i] == PARTICLE_TRACER) {
-        Vec2 tsx_y = WorldToScreenParallax(s->world.particles.target_pos[i], 1.0f, s, win_w, win_h); 
+        Vec2 tsx_y = WorldToScreenParallax(s->world.tracers.target_pos[i], 1.0f, s, win_w, win_h); 
         float a_f = fminf(1.0f, s->world.particles.life[i]); 
         
-        int ui = s->world.particles.unit_idx[i];
+        int ui = s->world.tracers.unit_idx[i];
         float thickness_mult = LASER_THICKNESS_MULT;
         float glow_mult = LASER_GLOW_MULT;
         float core_thickness_mult = LASER_CORE_THICKNESS_MULT;
         
-        if (ui >= 0 && ui < MAX_UNITS && s->world.units.active[ui]) {
+        if (ui >= 0 && ui < MAX_UNITS && Bits_Test(s->world.units.active, ui)) {
             thickness_mult = s->world.units.stats[ui]->laser_thickness;
             glow_mult = s->world.units.stats[ui]->laser_glow_mult;
             core_thickness_mult = s->world.units.stats[ui]->laser_core_thickness_mult;
@@ -289,11 +315,13 @@ static void Renderer_DrawParticles(SDL_Renderer *r, const AppState *s, int win_w
             vb[5].position = (SDL_FPoint){ tsx_y.x - nx * cur_th, tsx_y.y - ny * cur_th }; vb[5].color = edge_col;
             int b_indices[12] = { 0, 1, 3, 1, 3, 4, 1, 2, 4, 2, 4, 5 };
             SDL_RenderGeometry(r, NULL, vb, 6, b_indices, 12);
+            calls++;
             if (th > 5.0f && a_f > 0.8f) { 
                 SDL_SetRenderDrawColor(r, 255, 255, 255, 255);
                 float flash_r = th * 2.5f;
                 SDL_FRect flash_rect = { tsx_y.x - flash_r/2, tsx_y.y - flash_r/2, flash_r, flash_r };
                 SDL_RenderFillRect(r, &flash_rect);
+                calls++;
             }
         }
     } else { 
@@ -301,6 +329,7 @@ static void Renderer_DrawParticles(SDL_Renderer *r, const AppState *s, int win_w
         SDL_RenderFillRect(r, &(SDL_FRect){sx_y.x - sz / 2, sx_y.y - sz / 2, sz, sz}); 
     }
   }
+  return calls;
 }
 
 static void DrawGrid(SDL_Renderer *renderer, const AppState *s, int win_w, int win_h) {
@@ -322,7 +351,7 @@ static void DrawGrid(SDL_Renderer *renderer, const AppState *s, int win_w, int w
       if (sx >= -10 && sx < win_w && sy >= -10 && sy < win_h) { char l[32]; snprintf(l, 32, "(%.0fk,%.0fk)", x / 1000.0f, y / 1000.0f); SDL_RenderDebugText(renderer, sx + 5, sy + 5, l); }
   }
   Vec2 m_pos; bool found = false;
-  for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) { m_pos = s->world.units.pos[i]; found = true; break; }
+  BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP) { m_pos = s->world.units.pos[i]; found = true; break; }
   if (found) {
       Vec2 ms = WorldToScreenParallax(m_pos, 1.0f, s, win_w, win_h);
       SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
@@ -353,12 +382,58 @@ static void DrawDebugInfo(SDL_Renderer *renderer, const AppState *s, int win_w)
   char ft[32]; snprintf(ft, 32, "FPS: %.0f", s->current_fps); SDL_RenderDebugText(renderer, 20, 20, ft);
   char ct[64]; snprintf(ct, 64, "Cam: %.1f, %.1f (x%.4f)", s->camera.pos.x, s->camera.pos.y, s->camera.zoom);
   SDL_RenderDebugText(renderer, 20, 40, ct);
+  const Histogram *fh = &s->frame_stats.frame_hist, *th = &s->frame_stats.tick_hist;
+  char fl[96]; snprintf(fl, 96, "Frame p50 %.1f p95 %.1f p99 %.1f p99.9 %.1f ms (stutters %d)", Histogram_Percentile(fh, 0.5), Histogram_Percentile(fh, 0.95), Histogram_Percentile(fh, 0.99), Histogram_Percentile(fh, 0.999), s->frame_stats.stutter_count);
+  SDL_RenderDebugText(renderer, 20, 60, fl);
+  char tl[96]; snprintf(tl, 96, "Tick  p50 %.2f p95 %.2f p99 %.2f p99.9 %.2f ms", Histogram_Percentile(th, 0.5), Histogram_Percentile(th, 0.95), Histogram_Percentile(th, 0.99), Histogram_Percentile(th, 0.999));
+  SDL_RenderDebugText(renderer, 20, 80, tl);
+  char wl[64]; snprintf(wl, 64, "Tick working set: %.1f KB", (double)Footprint_TickWorkingSet(s) / 1024.0);
+  SDL_RenderDebugText(renderer, 20, 100, wl);
   SDL_SetRenderScale(renderer, 1.0f, 1.0f);
 }
 
+// Zone tree with current/average ms, then a stacked bar per frame for the history window
+static void DrawProfilerOverlay(SDL_Renderer *r, const AppState *s) {
+  const float x0 = 20.0f, y0 = 110.0f, line_h = 10.0f, bar_w = 2.0f, chart_h = 120.0f, ms_to_px = chart_h / 33.3f;
+  int frames = s->profiler.history_count;
+  float tree_h = (PROF_ZONE_COUNT + 2) * line_h;
+  SDL_SetRenderDrawColor(r, 0, 0, 0, 170); SDL_RenderFillRect(r, &(SDL_FRect){x0 - 5, y0 - 5, PROFILER_HISTORY_FRAMES * bar_w + 10, tree_h + chart_h + 15});
+
+  for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+    const ProfileZoneInfo *info = Profiler_GetZoneInfo(z);
+    float avg = 0.0f;
+    for (int a = 0; a < frames; a++) avg += Profiler_GetHistoryMs(s, a, z);
+    if (frames > 0) avg /= frames;
+    float y = y0 + z * line_h, x = x0 + Profiler_GetZoneDepth(z) * 12.0f;
+    SDL_SetRenderDrawColor(r, info->color.r, info->color.g, info->color.b, 255); SDL_RenderFillRect(r, &(SDL_FRect){x, y + 1, 6, 6});
+    char line[96]; snprintf(line, sizeof(line), "%-16s %6.2f  avg %6.2f", info->name, Profiler_GetHistoryMs(s, 0, z), avg);
+    SDL_SetRenderDrawColor(r, 220, 220, 220, 255); SDL_RenderDebugText(r, x + 10, y, line);
+  }
+  char tl[64]; snprintf(tl, sizeof(tl), "targeting thread pass %6.2f ms", SDL_GetAtomicInt((SDL_AtomicInt *)&s->threads.targeting_pass_us) / 1000.0f);
+  SDL_RenderDebugText(r, x0, y0 + PROF_ZONE_COUNT * line_h + 2, tl);
+
+  // Stack the direct children of update/render; whatever is left of the frame shows as grey
+  float base_y = y0 + tree_h + chart_h;
+  for (int a = 0; a < frames; a++) {
+    float x = x0 + (PROFILER_HISTORY_FRAMES - 1 - a) * bar_w, y = base_y, used = 0.0f;
+    for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+      if (Profiler_GetZoneDepth(z) != 2 && z != PROF_TARGETING) continue;
+      const ProfileZoneInfo *info = Profiler_GetZoneInfo(z);
+      float ms = Profiler_GetHistoryMs(s, a, z), h = ms * ms_to_px;
+      used += ms;
+      if (h <= 0.0f) continue;
+      SDL_SetRenderDrawColor(r, info->color.r, info->color.g, info->color.b, 220); SDL_RenderFillRect(r, &(SDL_FRect){x, y - h, bar_w, h});
+      y -= h;
+    }
+    float rest = (Profiler_GetHistoryMs(s, a, PROF_FRAME) - used) * ms_to_px;
+    if (rest > 0.0f) { SDL_SetRenderDrawColor(r, 70, 70, 70, 220); SDL_RenderFillRect(r, &(SDL_FRect){x, y - rest, bar_w, rest}); }
+  }
+  // 60 Hz budget line
+  SDL_SetRenderDrawColor(r, 255, 255, 255, 90); SDL_RenderLine(r, x0, base_y - 16.67f * ms_to_px, x0 + PROFILER_HISTORY_FRAMES * bar_w, base_y - 16.67f * ms_to_px);
+}
+
 static bool IsInRangeOfAnyUnit(const AppState *s, Vec2 world_pos) {
-    for (int i = 0; i < MAX_UNITS; i++) {
-        if (!s->world.units.active[i]) continue;
+    BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) {
         float r = s->world.units.stats[i]->radar_range;
         if (Vector_DistanceSq(world_pos, s->world.units.pos[i]) < r * r) return true;
     }
@@ -384,7 +459,7 @@ static void DrawMinimap(SDL_Renderer *r, const AppState *s, int win_w, int win_h
         }
       }
   }
-  for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i]) {
+  BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) {
       float dx = (s->world.units.pos[i].x - cx), dy = (s->world.units.pos[i].y - cy);
       if (fabsf(dx) < MINIMAP_RANGE / 2 && fabsf(dy) < MINIMAP_RANGE / 2) {
           float px = mm_x + MINIMAP_SIZE / 2 + dx * wmm, py = mm_y + MINIMAP_SIZE / 2 + dy * wmm;
@@ -393,8 +468,8 @@ static void DrawMinimap(SDL_Renderer *r, const AppState *s, int win_w, int win_h
   }
   // Radar: Asteroids (Limited by Unit Radar Range)
   SDL_SetRenderDrawColor(r, 200, 50, 50, 200); 
-  for (int i = 0; i < MAX_ASTEROIDS; i++) {
-      if (!s->world.asteroids.active[i]) continue;
+  for (int k = 0; k < s->world.slots.asteroids.live_count; k++) {
+      int i = s->world.slots.asteroids.live[k];
       if (!IsInRangeOfAnyUnit(s, s->world.asteroids.pos[i])) continue;
       float dx = s->world.asteroids.pos[i].x - cx, dy = s->world.asteroids.pos[i].y - cy;
       if (fabsf(dx) < MINIMAP_RANGE / 2 && fabsf(dy) < MINIMAP_RANGE / 2) {
@@ -403,8 +478,8 @@ static void DrawMinimap(SDL_Renderer *r, const AppState *s, int win_w, int win_h
   }
   // Radar: Crystals (Limited by Unit Radar Range)
   SDL_SetRenderDrawColor(r, 50, 200, 255, 200);
-  for (int i = 0; i < MAX_RESOURCES; i++) {
-      if (!s->world.resources.active[i]) continue;
+  for (int k = 0; k < s->world.slots.resources.live_count; k++) {
+      int i = s->world.slots.resources.live[k];
       if (!IsInRangeOfAnyUnit(s, s->world.resources.pos[i])) continue;
       float dx = s->world.resources.pos[i].x - cx, dy = s->world.resources.pos[i].y - cy;
       if (fabsf(dx) < MINIMAP_RANGE / 2 && fabsf(dy) < MINIMAP_RANGE / 2) {
@@ -431,30 +506,30 @@ static void DrawTargetRing(SDL_Renderer *r, float x, float y, float radius, SDL_
     }
 }
 
-static void Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, int win_h) {
-  for (int i = 0; i < MAX_UNITS; i++) {
-    if (!s->world.units.active[i]) continue;
-    Vec2 sx_y = WorldToScreenParallax(s->world.units.pos[i], 1.0f, s, win_w, win_h); float rad = s->world.units.stats[i]->radius * s->camera.zoom;
+static int Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, int win_h) {
+  int calls = 0;
+  BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) {
+    Vec2 sx_y = WorldToScreenParallax(LerpPos(s->world.units.prev_pos, s->world.units.pos, i, s->render_alpha), 1.0f, s, win_w, win_h); float rad = s->world.units.stats[i]->radius * s->camera.zoom;
+    float rot = LerpAngle(s->world.units.prev_rotation, s->world.units.rotation, i, s->render_alpha);
         if (s->world.units.type[i] == UNIT_MOTHERSHIP) {
           float v_scale = s->world.units.stats[i]->visual_scale;
           bool unit_visible = IsVisible(sx_y.x, sx_y.y, rad * v_scale, win_w, win_h);
           
           if (unit_visible) {
-              if (s->world.units.large_target_idx[i] != -1) {
-                  int ti = s->world.units.large_target_idx[i];
+              int ti = Slots_Asteroid(s, s->world.targets.large[i]);
+              if (ti != -1) {
                   float dx = s->world.asteroids.pos[ti].x - s->world.units.pos[i].x, dy = s->world.asteroids.pos[ti].y - s->world.units.pos[i].y;
                   float dist = sqrtf(dx * dx + dy * dy);
                   SDL_Color col = (dist <= s->world.units.stats[i]->main_cannon_range + s->world.asteroids.radius[ti]) ? (SDL_Color){255, 50, 50, 180} : (SDL_Color){100, 100, 100, 80};
-                  Vec2 tsx = WorldToScreenParallax(s->world.asteroids.pos[ti], 1.0f, s, win_w, win_h);
+                  Vec2 tsx = WorldToScreenParallax(LerpPos(s->world.asteroids.prev_pos, s->world.asteroids.pos, ti, s->render_alpha), 1.0f, s, win_w, win_h);
                   float ring_sz = (s->world.asteroids.radius[ti] * 0.45f) * s->camera.zoom;
                   DrawTargetRing(r, tsx.x, tsx.y, fmaxf(15.0f, ring_sz), col);
               }
-              for (int c = 0; c < 4; c++) if (s->world.units.small_target_idx[i][c] != -1) {
-                  int ti = s->world.units.small_target_idx[i][c];
+              for (int c = 0; c < 4; c++) if ((ti = Slots_Asteroid(s, s->world.targets.small[i][c])) != -1) {
                   float dx = s->world.asteroids.pos[ti].x - s->world.units.pos[i].x, dy = s->world.asteroids.pos[ti].y - s->world.units.pos[i].y;
                   float dist = sqrtf(dx * dx + dy * dy);
                   SDL_Color col = (dist <= s->world.units.stats[i]->small_cannon_range + s->world.asteroids.radius[ti]) ? (SDL_Color){255, 100, 100, 150} : (SDL_Color){100, 100, 100, 80};
-                  Vec2 tsx = WorldToScreenParallax(s->world.asteroids.pos[ti], 1.0f, s, win_w, win_h);
+                  Vec2 tsx = WorldToScreenParallax(LerpPos(s->world.asteroids.prev_pos, s->world.asteroids.pos, ti, s->render_alpha), 1.0f, s, win_w, win_h);
                   float ring_sz = (s->world.asteroids.radius[ti] * 0.4f) * s->camera.zoom;
                   DrawTargetRing(r, tsx.x, tsx.y, fmaxf(10.0f, ring_sz), col);
               }
@@ -462,7 +537,8 @@ static void Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, in
                             float dr = rad * v_scale;
                             SDL_RenderTextureRotated(r, s->textures.mothership_hull_texture, NULL, 
                                 &(SDL_FRect){sx_y.x - dr, sx_y.y - dr, dr * 2, dr * 2},
-                                s->world.units.rotation[i], NULL, SDL_FLIP_NONE);
+                                rot, NULL, SDL_FLIP_NONE);
+                            calls++;
                         }
                     }
                   } else {
@@ -474,19 +550,21 @@ static void Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, in
                               float dr = rad * v_scale;
                               SDL_RenderTextureRotated(r, s->textures.miner_texture, NULL, 
                                   &(SDL_FRect){sx_y.x - dr, sx_y.y - dr, dr * 2, dr * 2},
-                                  s->world.units.rotation[i], NULL, SDL_FLIP_NONE);
+                                  rot, NULL, SDL_FLIP_NONE);
+                              calls++;
                           } else if (s->world.units.type[i] == UNIT_FIGHTER && s->textures.fighter_texture) {
                               float dr = rad * v_scale;
                               SDL_RenderTextureRotated(r, s->textures.fighter_texture, NULL, 
                                   &(SDL_FRect){sx_y.x - dr, sx_y.y - dr, dr * 2, dr * 2},
-                                  s->world.units.rotation[i], NULL, SDL_FLIP_NONE);
+                                  rot, NULL, SDL_FLIP_NONE);
+                              calls++;
                           } else {
                               SDL_Color col = {150, 150, 255, 255};
                               if (s->world.units.type[i] == UNIT_MINER) col = (SDL_Color){200, 200, 50, 255};
                               else if (s->world.units.type[i] == UNIT_FIGHTER) col = (SDL_Color){255, 100, 100, 255};
                               else if (s->world.units.type[i] == UNIT_SCOUT) col = (SDL_Color){100, 255, 255, 255};
 
-                              float ang = s->world.units.rotation[i] * (SDL_PI_F / 180.0f);
+                              float ang = rot * (SDL_PI_F / 180.0f);
                               float r_vis = rad * v_scale;
                               // Simple Triangle
                               float p1x = sx_y.x + cosf(ang) * r_vis;
@@ -500,6 +578,7 @@ static void Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, in
                               SDL_RenderLine(r, p1x, p1y, p2x, p2y);
                               SDL_RenderLine(r, p2x, p2y, p3x, p3y);
                               SDL_RenderLine(r, p3x, p3y, p1x, p1y);
+                              calls += 3;
                           }
                       }
                   }
@@ -535,7 +614,7 @@ static void Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, in
                   }
 
                   // 2. Status Bars for selected units
-                  if (s->selection.primary_unit_idx == i || s->selection.unit_selected[i]) {
+                  if (s->selection.primary_unit_idx == i || Bits_Test(s->selection.unit_selected, i)) {
                       float v_scale = s->world.units.stats[i]->visual_scale;
                       float bw = rad * 1.5f, bh = 4.0f, by = sx_y.y + rad * v_scale + 5.0f;
                       
@@ -566,24 +645,24 @@ static void Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, in
                       // 4. Main Cannon Cooldown (Mothership Only)
                       if (s->world.units.type[i] == UNIT_MOTHERSHIP && s->world.units.stats[i]->main_cannon_damage > 0) {
                           SDL_SetRenderDrawColor(r, 40, 0, 40, 200); SDL_RenderFillRect(r, &(SDL_FRect){sx_y.x - bw/2, by, bw, bh});
-                          float cd_pct = s->world.units.large_cannon_cooldown[i] / s->world.units.stats[i]->main_cannon_cooldown;
+                          float cd_pct = s->world.targets.large_cooldown[i] / s->world.units.stats[i]->main_cannon_cooldown;
                           SDL_SetRenderDrawColor(r, 200, 50, 255, 255); SDL_RenderFillRect(r, &(SDL_FRect){sx_y.x - bw/2, by, bw * (1.0f - cd_pct), bh});
                       }
                   }
               
                   if (s->selection.primary_unit_idx == i) {
-                      if (s->world.units.has_target[i]) {                Vec2 lp = sx_y;
+                      if (s->world.orders.has_target[i]) {                Vec2 lp = sx_y;
                 float v_scale = s->world.units.stats[i]->visual_scale;
                 float visual_rad_px = s->world.units.stats[i]->radius * v_scale * s->camera.zoom;
-            for (int q = s->world.units.command_current_idx[i]; q < s->world.units.command_count[i]; q++) {
-                if (s->world.units.command_queue[i][q].type == CMD_RETURN_CARGO) continue; // Don't draw waypoint to mothership
+            for (int q = s->world.orders.current_idx[i]; q < s->world.orders.count[i]; q++) {
+                if (s->world.orders.queue[i][q].type == CMD_RETURN_CARGO) continue; // Don't draw waypoint to mothership
                 
-                Vec2 wt = s->world.units.command_queue[i][q].pos;
+                Vec2 wt = s->world.orders.queue[i][q].pos;
                 Vec2 tsx = WorldToScreenParallax(wt, 1.0f, s, win_w, win_h);
-                if (s->world.units.command_queue[i][q].type == CMD_PATROL) SDL_SetRenderDrawColor(r, 100, 100, 255, 180);
-                else if (s->world.units.command_queue[i][q].type == CMD_ATTACK_MOVE) SDL_SetRenderDrawColor(r, 255, 100, 100, 180);
+                if (s->world.orders.queue[i][q].type == CMD_PATROL) SDL_SetRenderDrawColor(r, 100, 100, 255, 180);
+                else if (s->world.orders.queue[i][q].type == CMD_ATTACK_MOVE) SDL_SetRenderDrawColor(r, 255, 100, 100, 180);
                 else SDL_SetRenderDrawColor(r, 100, 255, 100, 180);
-                if (q == s->world.units.command_current_idx[i]) {
+                if (q == s->world.orders.current_idx[i]) {
                     float dx = tsx.x - lp.x, dy = tsx.y - lp.y;
                     float dist = sqrtf(dx*dx + dy*dy);
                     if (dist > visual_rad_px) {
@@ -595,12 +674,12 @@ static void Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, in
                 lp = tsx;
                 SDL_RenderRect(r, &(SDL_FRect){tsx.x - 3, tsx.y - 3, 6, 6});
             }
-            if (s->world.units.command_count[i] > 0 && s->world.units.command_queue[i][s->world.units.command_count[i] - 1].type == CMD_PATROL) {
-                int first_patrol = s->world.units.command_count[i] - 1;
-                while (first_patrol > 0 && s->world.units.command_queue[i][first_patrol - 1].type == CMD_PATROL) first_patrol--;
-                if (first_patrol < s->world.units.command_count[i] - 1) {
-                    Vec2 p1 = WorldToScreenParallax(s->world.units.command_queue[i][s->world.units.command_count[i] - 1].pos, 1.0f, s, win_w, win_h);
-                    Vec2 p2 = WorldToScreenParallax(s->world.units.command_queue[i][first_patrol].pos, 1.0f, s, win_w, win_h);
+            if (s->world.orders.count[i] > 0 && s->world.orders.queue[i][s->world.orders.count[i] - 1].type == CMD_PATROL) {
+                int first_patrol = s->world.orders.count[i] - 1;
+                while (first_patrol > 0 && s->world.orders.queue[i][first_patrol - 1].type == CMD_PATROL) first_patrol--;
+                if (first_patrol < s->world.orders.count[i] - 1) {
+                    Vec2 p1 = WorldToScreenParallax(s->world.orders.queue[i][s->world.orders.count[i] - 1].pos, 1.0f, s, win_w, win_h);
+                    Vec2 p2 = WorldToScreenParallax(s->world.orders.queue[i][first_patrol].pos, 1.0f, s, win_w, win_h);
                     SDL_SetRenderDrawColor(r, 100, 100, 255, 80);
                     SDL_RenderLine(r, p1.x, p1.y, p2.x, p2.y);
                 }
@@ -608,6 +687,7 @@ static void Renderer_DrawUnits(SDL_Renderer *r, const AppState *s, int win_w, in
         }
     }
   }
+  return calls;
 }
 
 void Renderer_Draw(AppState *s) {
@@ -616,11 +696,21 @@ void Renderer_Draw(AppState *s) {
       SDL_SetRenderDrawColor(s->renderer, 50, 0, 0, 255); SDL_RenderClear(s->renderer); SDL_SetRenderDrawColor(s->renderer, 255, 255, 255, 255); SDL_SetRenderScale(s->renderer, 4.0f, 4.0f); SDL_RenderDebugText(s->renderer, (ww / 8.0f) - 40, (wh / 8.0f) - 10, "GAME OVER");
       SDL_SetRenderScale(s->renderer, 1.0f, 1.0f); SDL_RenderDebugText(s->renderer, (ww / 2.0f) - 80, (wh / 2.0f) + 40, "The Mothership has been destroyed."); SDL_RenderDebugText(s->renderer, (ww / 2.0f) - 60, (wh / 2.0f) + 60, "Press ESC to quit."); SDL_RenderPresent(s->renderer); return;
   }
+  Profiler_Begin(s, PROF_RENDER);
+  // Draw from the interpolated camera, restore the sim camera afterwards
+  Vec2 sim_cam = s->camera.pos;
+  s->camera.pos.x = s->camera.prev_pos.x + (sim_cam.x - s->camera.prev_pos.x) * s->render_alpha;
+  s->camera.pos.y = s->camera.prev_pos.y + (sim_cam.y - s->camera.prev_pos.y) * s->render_alpha;
   SDL_SetRenderDrawColor(s->renderer, 0, 0, 0, 255); SDL_RenderClear(s->renderer);
   SDL_SetRenderDrawBlendMode(s->renderer, SDL_BLENDMODE_BLEND);
+  Profiler_Begin(s, PROF_RENDER_BACKGROUND);
   Workers_UpdateBackground(s); Workers_UpdateDensityMap(s); 
   if (s->textures.bg_texture) SDL_RenderTexture(s->renderer, s->textures.bg_texture, NULL, NULL);
+  Profiler_End(s, PROF_RENDER_BACKGROUND);
+  Profiler_Begin(s, PROF_RENDER_PARALLAX);
   DrawParallaxLayer(s->renderer, s, ww, wh, 512, 0.1f, 0, StarLayerFn); DrawParallaxLayer(s->renderer, s, ww, wh, SYSTEM_LAYER_CELL_SIZE, SYSTEM_LAYER_PARALLAX, 1000, SystemLayerFn);
+  Profiler_End(s, PROF_RENDER_PARALLAX);
+  Profiler_Begin(s, PROF_RENDER_HUD);
   if (s->input.show_grid) DrawGrid(s->renderer, s, ww, wh);
   if (s->input.pending_input_type == INPUT_TARGET || s->input.pending_cmd_type != CMD_IDLE) {
       float wx = s->camera.pos.x + s->input.mouse_pos.x / s->camera.zoom;
@@ -636,8 +726,10 @@ void Renderer_Draw(AppState *s) {
       ring_col.a = (Uint8)(ring_col.a * pulse);
       DrawTargetRing(s->renderer, s->input.mouse_pos.x, s->input.mouse_pos.y, 15.0f, ring_col);
 
-      for (int a = 0; a < MAX_ASTEROIDS; a++) {
-          if (!s->world.asteroids.active[a]) continue;
+      int ids[SPATIAL_MAX_IDS];
+      int n = Spatial_QueryRadius(s, &s->world.grid, (Vec2){wx, wy}, s->world.grid.max_radius[SPATIAL_ASTEROID] * ASTEROID_HITBOX_MULT, SPATIAL_MASK(SPATIAL_ASTEROID), ids, SPATIAL_MAX_IDS);
+      for (int k = 0; k < n; k++) {
+          int a = ids[k];
           float dx = s->world.asteroids.pos[a].x - wx, dy = s->world.asteroids.pos[a].y - wy;
           float hit_r = s->world.asteroids.radius[a] * ASTEROID_HITBOX_MULT;
           if (dx*dx + dy*dy < hit_r * hit_r) {
@@ -648,22 +740,29 @@ void Renderer_Draw(AppState *s) {
           }
       }
   }
-  if (s->input.hover_asteroid_idx != -1 && s->input.pending_input_type == INPUT_NONE) {
-      Vec2 as = WorldToScreenParallax(s->world.asteroids.pos[s->input.hover_asteroid_idx], 1.0f, s, ww, wh);
-      float cross_sz = (s->world.asteroids.radius[s->input.hover_asteroid_idx] * ASTEROID_HITBOX_MULT * 2.1f) * s->camera.zoom;
+  int hover_a = Slots_Asteroid(s, s->input.hover_asteroid);
+  if (hover_a != -1 && s->input.pending_input_type == INPUT_NONE) {
+      Vec2 as = WorldToScreenParallax(s->world.asteroids.pos[hover_a], 1.0f, s, ww, wh);
+      float cross_sz = (s->world.asteroids.radius[hover_a] * ASTEROID_HITBOX_MULT * 2.1f) * s->camera.zoom;
       DrawTargetCrosshair(s->renderer, as.x, as.y, cross_sz, (SDL_Color){255, 50, 50, 180}); // Red for asteroids
   }
-  if (s->input.hover_resource_idx != -1 && s->input.pending_input_type == INPUT_NONE) {
-      Vec2 rs = WorldToScreenParallax(s->world.resources.pos[s->input.hover_resource_idx], 1.0f, s, ww, wh);
-      float cross_sz = (s->world.resources.radius[s->input.hover_resource_idx] * CRYSTAL_VISUAL_SCALE * 1.5f) * s->camera.zoom;
+  int hover_r = Slots_Resource(s, s->input.hover_resource);
+  if (hover_r != -1 && s->input.pending_input_type == INPUT_NONE) {
+      Vec2 rs = WorldToScreenParallax(s->world.resources.pos[hover_r], 1.0f, s, ww, wh);
+      float cross_sz = (s->world.resources.radius[hover_r] * CRYSTAL_VISUAL_SCALE * 1.5f) * s->camera.zoom;
       DrawTargetCrosshair(s->renderer, rs.x, rs.y, cross_sz, (SDL_Color){50, 255, 50, 180}); // Green for resources
   }
-  Renderer_DrawAsteroids(s->renderer, s, ww, wh);
-  Renderer_DrawCrystals(s->renderer, s, ww, wh);
-  Renderer_DrawUnits(s->renderer, s, ww, wh); 
-  Renderer_DrawParticles(s->renderer, s, ww, wh);
+  Profiler_End(s, PROF_RENDER_HUD);
+  // World passes report the sprite/primitive draws they issue; HUD overlays are not counted
+  s->counters.draw_calls = 0;
+  Profiler_Begin(s, PROF_RENDER_ASTEROIDS); s->counters.draw_calls += Renderer_DrawAsteroids(s->renderer, s, ww, wh); Profiler_End(s, PROF_RENDER_ASTEROIDS);
+  Profiler_Begin(s, PROF_RENDER_CRYSTALS); s->counters.draw_calls += Renderer_DrawCrystals(s->renderer, s, ww, wh); Profiler_End(s, PROF_RENDER_CRYSTALS);
+  Profiler_Begin(s, PROF_RENDER_UNITS); s->counters.draw_calls += Renderer_DrawUnits(s->renderer, s, ww, wh); Profiler_End(s, PROF_RENDER_UNITS);
+  Profiler_Begin(s, PROF_RENDER_PARTICLES); s->counters.draw_calls += Renderer_DrawParticles(s->renderer, s, ww, wh); Profiler_End(s, PROF_RENDER_PARTICLES);
+  Profiler_Begin(s, PROF_RENDER_HUD);
   if (s->selection.box_active) { float x1 = fminf(s->selection.box_start.x, s->selection.box_current.x), y1 = fminf(s->selection.box_start.y, s->selection.box_current.y), w = fabsf(s->selection.box_start.x - s->selection.box_current.x), h = fabsf(s->selection.box_start.y - s->selection.box_current.y); SDL_SetRenderDrawColor(s->renderer, 0, 255, 0, 50); SDL_RenderFillRect(s->renderer, &(SDL_FRect){x1, y1, w, h}); SDL_SetRenderDrawColor(s->renderer, 0, 255, 0, 200); SDL_RenderRect(s->renderer, &(SDL_FRect){x1, y1, w, h}); }
   DrawDebugInfo(s->renderer, s, ww); DrawMinimap(s->renderer, s, ww, wh); UI_DrawHUD(s);
+  if (s->input.show_profiler) DrawProfilerOverlay(s->renderer, s);
   if (s->game_state == STATE_PAUSED) {
       SDL_SetRenderDrawColor(s->renderer, 0, 0, 0, 150); SDL_RenderFillRect(s->renderer, &(SDL_FRect){0, 0, (float)ww, (float)wh});
       SDL_SetRenderDrawColor(s->renderer, 255, 255, 255, 255);
@@ -673,5 +772,10 @@ void Renderer_Draw(AppState *s) {
       SDL_RenderDebugText(s->renderer, (ww / 2.0f) - 100, (wh / 2.0f) + 20, "Press ENTER to Exit");
       SDL_RenderDebugText(s->renderer, (ww / 2.0f) - 100, (wh / 2.0f) + 40, "Press ESC to Continue");
   }
+  s->camera.pos = sim_cam;
+  Profiler_End(s, PROF_RENDER_HUD);
+  Profiler_Begin(s, PROF_RENDER_PRESENT);
   SDL_RenderPresent(s->renderer);
+  Profiler_End(s, PROF_RENDER_PRESENT);
+  Profiler_End(s, PROF_RENDER);
 }
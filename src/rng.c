@@ -0,0 +1,27 @@
+#include "rng.h"
+
+Uint32 Rng_Next(Rng *r) {
+  Uint64 old = r->state;
+  r->state = old * 6364136223846793005ULL + r->inc;
+  Uint32 xorshifted = (Uint32)(((old >> 18u) ^ old) >> 27u);
+  Uint32 rot = (Uint32)(old >> 59u);
+  return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+}
+
+void Rng_Seed(Rng *r, Uint64 seed, Uint64 stream) {
+  r->state = 0;
+  r->inc = (stream << 1u) | 1u;
+  Rng_Next(r);
+  r->state += seed;
+  Rng_Next(r);
+}
+
+// Multiply-shift keeps the range unbiased enough for gameplay without a modulo
+int Rng_Int(Rng *r, int n) {
+  if (n <= 0) return 0;
+  return (int)(((Uint64)Rng_Next(r) * (Uint64)n) >> 32);
+}
+
+float Rng_Float(Rng *r) {
+  return (float)(Rng_Next(r) >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,88 @@
+#include "constants.h"
+#include "headless.h"
+#include "trace.h"
+#include "histogram.h"
+#include "counters.h"
+#include "footprint.h"
+#include "spatial.h"
+#include "jobs.h"
+#include <SDL3/SDL.h>
+#include <stdio.h>
+
+static void PrintUsage(const char *exe) {
+  printf("usage: %s [--seed N] [--ticks N] [--viewport WxH] [--tick-rate HZ] [--trace FILE] [--counters FILE] [--broadphase grid|sap] [--jobs N] [--no-vfx] [--quiet]\n", exe);
+}
+
+int main(int argc, char *argv[]) {
+  unsigned int seed = 1;
+  int ticks = 600;
+  int view_w = 1280, view_h = 720;
+  int tick_rate = SIM_TICK_RATE;
+  bool quiet = false;
+  const char *trace_path = NULL;
+  const char *counters_path = NULL;
+  BroadphaseMode broadphase = BROADPHASE_GRID;
+  int jobs = Jobs_DefaultWorkerCount();
+  bool no_vfx = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (SDL_strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = (unsigned int)SDL_strtoull(argv[++i], NULL, 10);
+    else if (SDL_strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) ticks = SDL_atoi(argv[++i]);
+    else if (SDL_strcmp(argv[i], "--viewport") == 0 && i + 1 < argc) {
+      if (sscanf(argv[++i], "%dx%d", &view_w, &view_h) != 2) { PrintUsage(argv[0]); return 1; }
+    }
+    else if (SDL_strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) tick_rate = SDL_atoi(argv[++i]);
+    else if (SDL_strcmp(argv[i], "--trace") == 0 && i + 1 < argc) trace_path = argv[++i];
+    else if (SDL_strcmp(argv[i], "--counters") == 0 && i + 1 < argc) counters_path = argv[++i];
+    else if (SDL_strcmp(argv[i], "--broadphase") == 0 && i + 1 < argc) {
+      if (!Spatial_ParseBroadphase(argv[++i], &broadphase)) { PrintUsage(argv[0]); return 1; }
+    }
+    else if (SDL_strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) jobs = SDL_atoi(argv[++i]);
+    else if (SDL_strcmp(argv[i], "--no-vfx") == 0) no_vfx = true;
+    else if (SDL_strcmp(argv[i], "--quiet") == 0) quiet = true;
+    else { PrintUsage(argv[0]); return 1; }
+  }
+  if (ticks <= 0 || view_w <= 0 || view_h <= 0 || tick_rate <= 0) { PrintUsage(argv[0]); return 1; }
+
+  if (!SDL_Init(0)) return 1;
+
+  AppState *s = SDL_aligned_alloc(_Alignof(AppState), sizeof(AppState)); // The particle lanes ask for 64
+  if (!s) return 1;
+  SDL_memset(s, 0, sizeof(AppState));
+  Headless_Init(s, seed, view_w, view_h);
+  s->sim_dt = 1.0f / (float)tick_rate;
+  s->world.broadphase = broadphase;
+  Jobs_Start(&s->jobs, jobs);
+  s->world.collision_events.skip_vfx = no_vfx;
+  if (!quiet) Footprint_LogReport(s);
+  if (counters_path && !Counters_Open(s, counters_path)) { fprintf(stderr, "failed to open %s\n", counters_path); return 1; }
+
+  double freq = (double)SDL_GetPerformanceFrequency();
+  double total_ms = 0.0, max_ms = 0.0;
+  size_t max_working_set = 0;
+  if (!quiet) printf("tick,ms,asteroids,units,resources,hash\n");
+  for (int t = 0; t < ticks; t++) {
+    Uint64 start = SDL_GetPerformanceCounter();
+    Headless_Step(s, s->sim_dt);
+    double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / freq;
+    total_ms += ms;
+    Histogram_Record(&s->frame_stats.tick_hist, ms);
+    Counters_EndTick(s, ms);
+    if (ms > max_ms) max_ms = ms;
+    size_t working_set = Footprint_TickWorkingSet(s);
+    if (working_set > max_working_set) max_working_set = working_set;
+    if (!quiet) printf("%d,%.4f,%d,%d,%d,%016" SDL_PRIx64 "\n", t, ms, s->world.asteroid_count, s->world.unit_count, s->world.resource_count, s->world.state_hash);
+  }
+  const Histogram *th = &s->frame_stats.tick_hist;
+  fprintf(stderr, "seed %u, %d ticks, viewport %dx%d: mean %.4f ms, p50 %.4f, p95 %.4f, p99 %.4f, p99.9 %.4f, max %.4f ms\n", seed, ticks, view_w, view_h, total_ms / ticks,
+          Histogram_Percentile(th, 0.5), Histogram_Percentile(th, 0.95), Histogram_Percentile(th, 0.99), Histogram_Percentile(th, 0.999), max_ms);
+  fprintf(stderr, "final state hash %016" SDL_PRIx64 ", peak tick working set %.1f KB\n", s->world.state_hash, (double)max_working_set / 1024.0);
+
+  if (trace_path && !Trace_WriteChromeJson(s, trace_path)) fprintf(stderr, "failed to write %s\n", trace_path);
+
+  Jobs_Stop(&s->jobs);
+  Counters_Close(s);
+  SDL_aligned_free(s);
+  SDL_Quit();
+  return 0;
+}
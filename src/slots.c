@@ -0,0 +1,171 @@
+#include "slots.h"
+#include "constants.h"
+
+#define SLOT_GENERATION_MASK 0x7FFF // Keeps handles positive so -1 stays free for "none"
+
+// One pool's SLOT_LIST plus its active flags
+typedef struct {
+  Uint16 *free, *live, *live_pos, *generation;
+  int *free_count, *live_count;
+  Uint64 *active;
+  int capacity;
+} SlotView;
+
+#define VIEW(list, pool_active, cap) \
+  ((SlotView){(list).free, (list).live, (list).live_pos, (list).generation, &(list).free_count, &(list).live_count, (pool_active), (cap)})
+
+// Read-only counterpart for Slots_Validate
+typedef struct {
+  const Uint16 *free, *live, *live_pos;
+  int free_count, live_count;
+  const Uint64 *active;
+  int capacity;
+} SlotReadView;
+
+#define READ_VIEW(list, pool_active, cap) ((SlotReadView){(list).free, (list).live, (list).live_pos, (list).free_count, (list).live_count, (pool_active), (cap)})
+
+static void Rebuild(SlotView v) {
+  *v.free_count = 0;
+  *v.live_count = 0;
+  for (int i = v.capacity - 1; i >= 0; i--)
+    if (!Bits_Test(v.active, i)) v.free[(*v.free_count)++] = (Uint16)i;
+  for (int i = Bits_Next(v.active, v.capacity, 0); i >= 0; i = Bits_Next(v.active, v.capacity, i + 1)) {
+    v.live_pos[i] = (Uint16)*v.live_count;
+    v.live[(*v.live_count)++] = (Uint16)i;
+  }
+}
+
+static int Alloc(SlotView v) {
+  if (*v.free_count == 0) return -1;
+  int idx = v.free[--(*v.free_count)];
+  Bits_Set(v.active, idx);
+  v.live_pos[idx] = (Uint16)*v.live_count;
+  v.live[(*v.live_count)++] = (Uint16)idx;
+  return idx;
+}
+
+// The last live slot moves into the freed one's place
+static void Free(SlotView v, int idx) {
+  Bits_Clear(v.active, idx);
+  v.generation[idx] = (Uint16)((v.generation[idx] + 1) & SLOT_GENERATION_MASK);
+  int pos = v.live_pos[idx];
+  int last = v.live[--(*v.live_count)];
+  v.live[pos] = (Uint16)last;
+  v.live_pos[last] = (Uint16)pos;
+  v.free[(*v.free_count)++] = (Uint16)idx;
+}
+
+static SlotView Asteroids(AppState *s) { return VIEW(s->world.slots.asteroids, s->world.asteroids.active, MAX_ASTEROIDS); }
+static SlotView Resources(AppState *s) { return VIEW(s->world.slots.resources, s->world.resources.active, MAX_RESOURCES); }
+static SlotView Units(AppState *s) { return VIEW(s->world.slots.units, s->world.units.active, MAX_UNITS); }
+static SlotView Particles(AppState *s) { return VIEW(s->world.slots.particles, s->world.particles.active, MAX_PARTICLES); }
+
+void Slots_Rebuild(AppState *s) {
+  Rebuild(Asteroids(s));
+  Rebuild(Resources(s));
+  Rebuild(Units(s));
+  Rebuild(Particles(s));
+  s->world.asteroid_count = s->world.slots.asteroids.live_count;
+  s->world.resource_count = s->world.slots.resources.live_count;
+  s->world.unit_count = s->world.slots.units.live_count;
+}
+
+int Slots_AllocAsteroid(AppState *s) {
+  int idx = Alloc(Asteroids(s));
+  if (idx >= 0) s->world.asteroid_count++;
+  return idx;
+}
+
+void Slots_FreeAsteroid(AppState *s, int idx) {
+  Free(Asteroids(s), idx);
+  s->world.asteroid_count--;
+}
+
+int Slots_AllocResource(AppState *s) {
+  int idx = Alloc(Resources(s));
+  if (idx >= 0) s->world.resource_count++;
+  return idx;
+}
+
+void Slots_FreeResource(AppState *s, int idx) {
+  Free(Resources(s), idx);
+  s->world.resource_count--;
+}
+
+int Slots_AllocUnit(AppState *s) {
+  int idx = Alloc(Units(s));
+  if (idx >= 0) s->world.unit_count++;
+  return idx;
+}
+
+void Slots_FreeUnit(AppState *s, int idx) {
+  Free(Units(s), idx);
+  s->world.unit_count--;
+}
+
+int Slots_AllocParticle(AppState *s) { return Alloc(Particles(s)); }
+
+void Slots_FreeParticle(AppState *s, int idx) { Free(Particles(s), idx); }
+
+static int Handle(const Uint16 *generation, int idx) {
+  return idx < 0 ? -1 : (int)(((Uint32)generation[idx] << 16) | (Uint32)idx);
+}
+
+static int Resolve(const Uint16 *generation, const Uint64 *active, int capacity, int handle) {
+  if (handle < 0) return -1;
+  int idx = handle & 0xFFFF;
+  if (idx >= capacity || !Bits_Test(active, idx) || generation[idx] != (Uint16)(handle >> 16)) return -1;
+  return idx;
+}
+
+int Slots_AsteroidHandle(const AppState *s, int idx) { return Handle(s->world.slots.asteroids.generation, idx); }
+int Slots_ResourceHandle(const AppState *s, int idx) { return Handle(s->world.slots.resources.generation, idx); }
+
+int Slots_Asteroid(const AppState *s, int handle) {
+  return Resolve(s->world.slots.asteroids.generation, s->world.asteroids.active, MAX_ASTEROIDS, handle);
+}
+int Slots_Resource(const AppState *s, int handle) {
+  return Resolve(s->world.slots.resources.generation, s->world.resources.active, MAX_RESOURCES, handle);
+}
+
+// pool_count < 0 skips the count check, for pools that don't keep one
+static bool Validate(const char *name, SlotReadView v, int pool_count) {
+  bool seen[SDL_max(MAX_PARTICLES, MAX_ASTEROIDS)] = {0};
+  bool ok = true;
+  for (int k = 0; k < v.free_count; k++) {
+    int idx = v.free[k];
+    if (idx >= v.capacity || Bits_Test(v.active, idx) || seen[idx]) {
+      SDL_Log("Slots: %s free entry %d holds %s slot %d", name, k, idx >= v.capacity ? "out of range" : Bits_Test(v.active, idx) ? "active" : "duplicate", idx);
+      ok = false;
+      continue;
+    }
+    seen[idx] = true;
+  }
+  for (int k = 0; k < v.live_count; k++) {
+    int idx = v.live[k];
+    if (idx >= v.capacity || !Bits_Test(v.active, idx) || v.live_pos[idx] != k) {
+      SDL_Log("Slots: %s live entry %d holds %s slot %d", name, k, idx >= v.capacity ? "out of range" : !Bits_Test(v.active, idx) ? "inactive" : "misplaced", idx);
+      ok = false;
+    }
+  }
+  int live = 0;
+  for (int i = Bits_Next(v.active, v.capacity, 0); i >= 0; i = Bits_Next(v.active, v.capacity, i + 1)) live++;
+  if (live + v.free_count != v.capacity || live != v.live_count) {
+    SDL_Log("Slots: %s has %d active slots but %d live and %d free", name, live, v.live_count, v.free_count);
+    ok = false;
+  }
+  if (pool_count >= 0 && pool_count != live) {
+    SDL_Log("Slots: %s count is %d but %d slots are active", name, pool_count, live);
+    ok = false;
+  }
+  return ok;
+}
+
+bool Slots_Validate(const AppState *s) {
+  const SlotLists *l = &s->world.slots;
+  bool ok = Validate("asteroids", READ_VIEW(l->asteroids, s->world.asteroids.active, MAX_ASTEROIDS), s->world.asteroid_count);
+  ok &= Validate("resources", READ_VIEW(l->resources, s->world.resources.active, MAX_RESOURCES), s->world.resource_count);
+  ok &= Validate("units", READ_VIEW(l->units, s->world.units.active, MAX_UNITS), s->world.unit_count);
+  ok &= Validate("particles", READ_VIEW(l->particles, s->world.particles.active, MAX_PARTICLES), -1);
+  return ok;
+}
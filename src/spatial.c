@@ -0,0 +1,275 @@
+#include "spatial.h"
+#include "constants.h"
+#include <float.h>
+#include <math.h>
+
+#define CELL_LIMIT 16777216.0f // Keeps far-off coordinates inside Sint32 cell space
+
+static Sint32 CellCoord(float v) { return (Sint32)fmaxf(-CELL_LIMIT, fminf(CELL_LIMIT, floorf(v / SPATIAL_CELL_SIZE))); }
+
+static int Bucket(Sint32 cx, Sint32 cy) {
+  return (int)((((Uint32)cx * 73856093u) ^ ((Uint32)cy * 19349663u)) & (SPATIAL_BUCKETS - 1));
+}
+
+typedef struct {
+  Vec2 pos;
+  float radius; // Collision radius
+  float size;   // Raw pool radius
+} SpatialShape;
+
+// Collision radius per id, matching SolveCollision's hitbox rules
+static bool GetShape(const AppState *s, int id, SpatialShape *out) {
+  int idx = Spatial_Index(id);
+  switch (Spatial_Kind(id)) {
+  case SPATIAL_ASTEROID:
+    if (!Bits_Test(s->world.asteroids.active, idx)) return false;
+    *out = (SpatialShape){s->world.asteroids.pos[idx], s->world.asteroids.radius[idx] * ASTEROID_HITBOX_MULT, s->world.asteroids.radius[idx]};
+    return true;
+  case SPATIAL_RESOURCE:
+    if (!Bits_Test(s->world.resources.active, idx)) return false;
+    *out = (SpatialShape){s->world.resources.pos[idx], s->world.resources.radius[idx] * ASTEROID_HITBOX_MULT, s->world.resources.radius[idx]};
+    return true;
+  case SPATIAL_UNIT:
+    if (!Bits_Test(s->world.units.active, idx)) return false;
+    *out = (SpatialShape){s->world.units.pos[idx], s->world.units.stats[idx]->radius, s->world.units.stats[idx]->radius};
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Lowest active id >= id across the three pools' occupancy bits, or -1
+static int NextActiveId(const AppState *s, int id) {
+  if (id < MAX_ASTEROIDS) {
+    int i = Bits_Next(s->world.asteroids.active, MAX_ASTEROIDS, id);
+    if (i >= 0) return Spatial_Id(SPATIAL_ASTEROID, i);
+    id = MAX_ASTEROIDS;
+  }
+  if (id < MAX_ASTEROIDS + MAX_RESOURCES) {
+    int i = Bits_Next(s->world.resources.active, MAX_RESOURCES, id - MAX_ASTEROIDS);
+    if (i >= 0) return Spatial_Id(SPATIAL_RESOURCE, i);
+    id = MAX_ASTEROIDS + MAX_RESOURCES;
+  }
+  int i = Bits_Next(s->world.units.active, MAX_UNITS, id - MAX_ASTEROIDS - MAX_RESOURCES);
+  return i >= 0 ? Spatial_Id(SPATIAL_UNIT, i) : -1;
+}
+
+static bool InMask(int id, Uint32 kind_mask) { return (kind_mask & SPATIAL_MASK(Spatial_Kind(id))) != 0; }
+
+// Counting sort into buckets: count, prefix-sum to bucket ends, then fill backwards
+void Spatial_Build(const AppState *s, SpatialGrid *g) {
+  SDL_memset(g->bucket_start, 0, sizeof(g->bucket_start));
+  SDL_memset(g->max_radius, 0, sizeof(g->max_radius));
+  g->entry_count = 0;
+  g->span_count = 0;
+  g->min_cx = g->min_cy = SDL_MAX_SINT32;
+  g->max_cx = g->max_cy = SDL_MIN_SINT32;
+  g->valid = false;
+
+  bool overflow = false;
+  for (int id = NextActiveId(s, 0); id >= 0; id = NextActiveId(s, id + 1)) {
+    SpatialShape sh;
+    GetShape(s, id, &sh);
+    // Callers pad their queries by max_radius, so it covers every shape even when the grid overflows
+    SpatialKind kind = Spatial_Kind(id);
+    if (sh.size > g->max_radius[kind]) g->max_radius[kind] = sh.size;
+    if (overflow) continue;
+    SpatialSpan *sp = &g->spans[g->span_count++];
+    *sp = (SpatialSpan){CellCoord(sh.pos.x - sh.radius), CellCoord(sh.pos.y - sh.radius), CellCoord(sh.pos.x + sh.radius), CellCoord(sh.pos.y + sh.radius), id};
+    g->entry_count += (sp->x1 - sp->x0 + 1) * (sp->y1 - sp->y0 + 1);
+    if (g->entry_count > SPATIAL_MAX_ENTRIES) {
+      overflow = true; // Queries fall back to the linear scan, which ignores the cells
+      continue;
+    }
+    for (Sint32 cy = sp->y0; cy <= sp->y1; cy++)
+      for (Sint32 cx = sp->x0; cx <= sp->x1; cx++) g->bucket_start[Bucket(cx, cy)]++;
+    if (sp->x0 < g->min_cx) g->min_cx = sp->x0;
+    if (sp->y0 < g->min_cy) g->min_cy = sp->y0;
+    if (sp->x1 > g->max_cx) g->max_cx = sp->x1;
+    if (sp->y1 > g->max_cy) g->max_cy = sp->y1;
+  }
+  if (overflow) return;
+
+  for (int b = 1; b <= SPATIAL_BUCKETS; b++) g->bucket_start[b] += g->bucket_start[b - 1];
+
+  // Spans are in id order, so walking them backwards leaves each bucket sorted by id
+  for (int k = g->span_count - 1; k >= 0; k--) {
+    const SpatialSpan *sp = &g->spans[k];
+    for (Sint32 cy = sp->y0; cy <= sp->y1; cy++)
+      for (Sint32 cx = sp->x0; cx <= sp->x1; cx++)
+        g->entries[--g->bucket_start[Bucket(cx, cy)]] = (SpatialEntry){cx, cy, sp->id, (Sint16)(cx - sp->x0), (Sint16)(cy - sp->y0)};
+  }
+  g->valid = true;
+}
+
+static int CompareInt(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x > y) - (x < y);
+}
+
+// Used while the grid is invalid: every active shape whose bounds overlap the box
+static int LinearAABB(const AppState *s, float min_x, float min_y, float max_x, float max_y, Uint32 kind_mask, int *out_ids, int max_out) {
+  int n = 0;
+  for (int id = NextActiveId(s, 0); id >= 0 && n < max_out; id = NextActiveId(s, id + 1)) {
+    SpatialShape sh;
+    if (!InMask(id, kind_mask) || !GetShape(s, id, &sh)) continue;
+    if (sh.pos.x + sh.radius < min_x || sh.pos.x - sh.radius > max_x || sh.pos.y + sh.radius < min_y || sh.pos.y - sh.radius > max_y) continue;
+    out_ids[n++] = id;
+  }
+  return n;
+}
+
+int Spatial_QueryAABB(const AppState *s, const SpatialGrid *g, float min_x, float min_y, float max_x, float max_y, Uint32 kind_mask, int *out_ids, int max_out) {
+  if (!g->valid) return LinearAABB(s, min_x, min_y, max_x, max_y, kind_mask, out_ids, max_out);
+  Sint32 x0 = SDL_max(CellCoord(min_x), g->min_cx), x1 = SDL_min(CellCoord(max_x), g->max_cx);
+  Sint32 y0 = SDL_max(CellCoord(min_y), g->min_cy), y1 = SDL_min(CellCoord(max_y), g->max_cy);
+  if (x0 > x1 || y0 > y1) return 0;
+
+  // An entity spanning several cells is reported only from the first of them inside the box
+  int n = 0;
+  if ((Sint64)(x1 - x0 + 1) * (y1 - y0 + 1) > SPATIAL_BUCKETS) {
+    // More cells than buckets: one pass over every entry is cheaper
+    for (int e = 0; e < g->entry_count && n < max_out; e++) {
+      const SpatialEntry *en = &g->entries[e];
+      if (en->cx < x0 || en->cx > x1 || en->cy < y0 || en->cy > y1) continue;
+      if ((en->ox != 0 && en->cx != x0) || (en->oy != 0 && en->cy != y0)) continue;
+      if (InMask(en->id, kind_mask)) out_ids[n++] = en->id;
+    }
+  } else {
+    for (Sint32 cy = y0; cy <= y1; cy++) {
+      for (Sint32 cx = x0; cx <= x1; cx++) {
+        int b = Bucket(cx, cy);
+        for (int e = g->bucket_start[b]; e < g->bucket_start[b + 1] && n < max_out; e++) {
+          const SpatialEntry *en = &g->entries[e];
+          if (en->cx != cx || en->cy != cy) continue; // Hash collision with another cell
+          if ((en->ox != 0 && cx != x0) || (en->oy != 0 && cy != y0)) continue;
+          if (InMask(en->id, kind_mask)) out_ids[n++] = en->id;
+        }
+      }
+    }
+  }
+  SDL_qsort(out_ids, n, sizeof(int), CompareInt);
+  return n;
+}
+
+int Spatial_QueryRadius(const AppState *s, const SpatialGrid *g, Vec2 center, float radius, Uint32 kind_mask, int *out_ids, int max_out) {
+  float pad = radius + SPATIAL_QUERY_MARGIN;
+  int n = Spatial_QueryAABB(s, g, center.x - pad, center.y - pad, center.x + pad, center.y + pad, kind_mask, out_ids, max_out);
+  int kept = 0;
+  for (int k = 0; k < n; k++) {
+    SpatialShape sh;
+    if (!GetShape(s, out_ids[k], &sh)) continue;
+    float dx = sh.pos.x - center.x, dy = sh.pos.y - center.y;
+    if (dx * dx + dy * dy <= radius * radius) out_ids[kept++] = out_ids[k];
+  }
+  return kept;
+}
+
+// Grows the search radius from one cell until something is found or the occupied bounds are covered
+int Spatial_QueryNearest(const AppState *s, const SpatialGrid *g, Vec2 center, float max_dist, Uint32 kind_mask) {
+  int ids[SPATIAL_MAX_IDS];
+  float r = g->valid ? fminf(max_dist, SPATIAL_CELL_SIZE) : max_dist;
+  for (;;) {
+    int n = Spatial_QueryRadius(s, g, center, r, kind_mask, ids, SPATIAL_MAX_IDS);
+    int best = -1;
+    float best_dsq = max_dist * max_dist;
+    for (int k = 0; k < n; k++) {
+      SpatialShape sh;
+      GetShape(s, ids[k], &sh);
+      float dx = sh.pos.x - center.x, dy = sh.pos.y - center.y, dsq = dx * dx + dy * dy;
+      if (dsq < best_dsq) { best_dsq = dsq; best = ids[k]; }
+    }
+    if (best != -1 || r >= max_dist) return best;
+    bool covers = center.x - r <= g->min_cx * SPATIAL_CELL_SIZE && center.x + r >= (g->max_cx + 1) * SPATIAL_CELL_SIZE &&
+                  center.y - r <= g->min_cy * SPATIAL_CELL_SIZE && center.y + r >= (g->max_cy + 1) * SPATIAL_CELL_SIZE;
+    if (covers) return -1;
+    r = fminf(max_dist, r * 2.0f);
+  }
+}
+
+// Marches the ray in chunks; a hit inside a chunk has its centre within one collision radius of that chunk
+int Spatial_Raycast(const AppState *s, const SpatialGrid *g, Vec2 origin, Vec2 dir, float max_dist, Uint32 kind_mask, float *out_t) {
+  int ids[SPATIAL_MAX_IDS];
+  float reach = 0.0f;
+  for (int k = 0; k < SPATIAL_KIND_COUNT; k++)
+    if (kind_mask & SPATIAL_MASK(k)) reach = fmaxf(reach, g->max_radius[k]);
+  reach += SPATIAL_QUERY_MARGIN;
+  float chunk = g->valid ? SPATIAL_CELL_SIZE * 4.0f : max_dist;
+
+  int best = -1;
+  float best_t = max_dist;
+  for (float t0 = 0.0f; t0 < max_dist; t0 += chunk) {
+    float t1 = fminf(max_dist, t0 + chunk);
+    Vec2 a = {origin.x + dir.x * t0, origin.y + dir.y * t0}, b = {origin.x + dir.x * t1, origin.y + dir.y * t1};
+    int n = Spatial_QueryAABB(s, g, fminf(a.x, b.x) - reach, fminf(a.y, b.y) - reach, fmaxf(a.x, b.x) + reach, fmaxf(a.y, b.y) + reach, kind_mask, ids, SPATIAL_MAX_IDS);
+    for (int k = 0; k < n; k++) {
+      SpatialShape sh;
+      if (!GetShape(s, ids[k], &sh)) continue;
+      float mx = origin.x - sh.pos.x, my = origin.y - sh.pos.y;
+      float bb = mx * dir.x + my * dir.y, c = mx * mx + my * my - sh.radius * sh.radius;
+      if (c > 0.0f && bb > 0.0f) continue;
+      float disc = bb * bb - c;
+      if (disc < 0.0f) continue;
+      float t = fmaxf(0.0f, -bb - sqrtf(disc));
+      if (t < best_t || (t == best_t && best == -1)) { best_t = t; best = ids[k]; }
+    }
+    if (best != -1 && best_t <= t1) break;
+  }
+  if (best != -1 && out_t) *out_t = best_t;
+  return best;
+}
+
+static const char *broadphase_names[BROADPHASE_COUNT] = {"grid", "sap"};
+
+const char *Spatial_BroadphaseName(BroadphaseMode mode) { return broadphase_names[mode]; }
+
+bool Spatial_ParseBroadphase(const char *name, BroadphaseMode *out) {
+  for (int m = 0; m < BROADPHASE_COUNT; m++) {
+    if (SDL_strcmp(name, broadphase_names[m]) == 0) { *out = (BroadphaseMode)m; return true; }
+  }
+  return false;
+}
+
+static bool SweepBefore(const SweepState *sw, int a, int b) {
+  return sw->min_x[a] < sw->min_x[b] || (sw->min_x[a] == sw->min_x[b] && a < b);
+}
+
+static int CompareUint32(const void *a, const void *b) {
+  Uint32 x = *(const Uint32 *)a, y = *(const Uint32 *)b;
+  return (x > y) - (x < y);
+}
+
+int Spatial_SweepPairs(const AppState *s, SweepState *sw) {
+  const AsteroidPool *ap = &s->world.asteroids;
+  if (!sw->seeded) {
+    for (int i = 0; i < MAX_ASTEROIDS; i++) sw->order[i] = (Sint16)i;
+    sw->seeded = true;
+  }
+  for (int i = 0; i < MAX_ASTEROIDS; i++) sw->min_x[i] = Spatial_AsteroidCollides(ap, i) ? ap->pos[i].x - ap->radius[i] * ASTEROID_HITBOX_MULT : FLT_MAX;
+
+  sw->shifts = 0;
+  for (int a = 1; a < MAX_ASTEROIDS; a++) {
+    int v = sw->order[a], b = a - 1;
+    while (b >= 0 && SweepBefore(sw, v, sw->order[b])) {
+      sw->order[b + 1] = sw->order[b];
+      b--;
+      sw->shifts++;
+    }
+    sw->order[b + 1] = (Sint16)v;
+  }
+
+  sw->pair_count = 0;
+  for (int a = 0; a < MAX_ASTEROIDS && sw->min_x[sw->order[a]] != FLT_MAX; a++) {
+    int i = sw->order[a];
+    float ri = ap->radius[i] * ASTEROID_HITBOX_MULT, max_x = ap->pos[i].x + ri;
+    for (int b = a + 1; b < MAX_ASTEROIDS && sw->min_x[sw->order[b]] <= max_x; b++) {
+      int j = sw->order[b];
+      if (!Spatial_BoundsOverlap(ap->pos[i], ri, ap->pos[j], ap->radius[j] * ASTEROID_HITBOX_MULT)) continue;
+      if (sw->pair_count == SWEEP_MAX_PAIRS) return -1;
+      sw->pairs[sw->pair_count++] = i < j ? ((Uint32)i << 16) | (Uint32)j : ((Uint32)j << 16) | (Uint32)i;
+    }
+  }
+  // Resolve in index order like the grid path, independent of where the sort left ties
+  SDL_qsort(sw->pairs, sw->pair_count, sizeof(Uint32), CompareUint32);
+  return sw->pair_count;
+}
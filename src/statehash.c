@@ -0,0 +1,61 @@
+#include "statehash.h"
+
+// Mixing step borrowed from xxHash64's round function
+static Uint64 Mix(Uint64 h, Uint64 v) {
+  h ^= v * 0xC2B2AE3D27D4EB4FULL;
+  h = (h << 31) | (h >> 33);
+  return h * 0x9E3779B97F4A7C15ULL;
+}
+
+static Uint64 FloatBits(float f) {
+  Uint32 u;
+  SDL_memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+static Uint64 Vec2Bits(Vec2 v) { return (FloatBits(v.x) << 32) | FloatBits(v.y); }
+
+static Uint64 Finalize(Uint64 h) {
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ULL;
+  return h ^ (h >> 33);
+}
+
+Uint64 StateHash_World(const AppState *s) {
+  Uint64 h = 0x27D4EB2F165667C5ULL;
+
+  const UnitPool *u = &s->world.units;
+  const UnitOrderPool *o = &s->world.orders;
+  BITS_FOR_EACH(i, u->active, MAX_UNITS) {
+    h = Mix(h, ((Uint64)i << 32) | (Uint32)u->type[i]);
+    h = Mix(h, Vec2Bits(u->pos[i]));
+    h = Mix(h, Vec2Bits(u->velocity[i]));
+    h = Mix(h, (FloatBits(u->health[i]) << 32) | FloatBits(u->energy[i]));
+    h = Mix(h, ((Uint64)(Uint32)o->count[i] << 32) | (Uint32)o->current_idx[i]);
+    for (int c = 0; c < o->count[i]; c++) {
+      const Command *cmd = &o->queue[i][c];
+      h = Mix(h, ((Uint64)(Uint32)cmd->type << 32) | (Uint32)cmd->target);
+      h = Mix(h, Vec2Bits(cmd->pos));
+    }
+  }
+
+  const AsteroidPool *a = &s->world.asteroids;
+  BITS_FOR_EACH(i, a->active, MAX_ASTEROIDS) {
+    h = Mix(h, ((Uint64)i << 32) | FloatBits(a->radius[i]));
+    h = Mix(h, Vec2Bits(a->pos[i]));
+    h = Mix(h, Vec2Bits(a->velocity[i]));
+    h = Mix(h, FloatBits(a->health[i]));
+  }
+
+  const ResourcePool *r = &s->world.resources;
+  BITS_FOR_EACH(i, r->active, MAX_RESOURCES) {
+    h = Mix(h, ((Uint64)i << 32) | FloatBits(r->radius[i]));
+    h = Mix(h, Vec2Bits(r->pos[i]));
+    h = Mix(h, Vec2Bits(r->velocity[i]));
+    h = Mix(h, (FloatBits(r->health[i]) << 32) | FloatBits(r->amount[i]));
+  }
+
+  return Finalize(h);
+}
@@ -0,0 +1,66 @@
+#include "trace.h"
+#include <stdio.h>
+
+static const char *thread_names[TRACE_THREAD_COUNT] = {"Main", "BG_Gen", "Density_Gen", "Targeting"};
+
+void Trace_Init(AppState *s) {
+  s->trace.base_counter = SDL_GetPerformanceCounter();
+  for (int t = 0; t < TRACE_THREAD_COUNT; t++) SDL_SetAtomicInt(&s->trace.rings[t].head, 0);
+}
+
+// Only the owning thread writes its ring; the release barrier publishes the event before the new head
+static void Push(AppState *s, TraceThread thread, const char *name, char phase) {
+  TraceRing *ring = &s->trace.rings[thread];
+  unsigned int head = (unsigned int)SDL_GetAtomicInt(&ring->head);
+  TraceEvent *e = &ring->events[head & (TRACE_RING_CAPACITY - 1)];
+  e->name = name;
+  e->ts = SDL_GetPerformanceCounter();
+  e->phase = phase;
+  SDL_MemoryBarrierRelease();
+  SDL_SetAtomicInt(&ring->head, (int)(head + 1));
+}
+
+void Trace_Begin(AppState *s, TraceThread thread, const char *name) { Push(s, thread, name, 'B'); }
+void Trace_End(AppState *s, TraceThread thread, const char *name) { Push(s, thread, name, 'E'); }
+void Trace_Instant(AppState *s, TraceThread thread, const char *name) { Push(s, thread, name, 'i'); }
+
+bool Trace_WriteChromeJson(AppState *s, const char *filename) {
+  FILE *f = fopen(filename, "w");
+  if (!f) return false;
+
+  TraceEvent *copy = SDL_malloc(sizeof(TraceEvent) * TRACE_RING_CAPACITY);
+  if (!copy) { fclose(f); return false; }
+
+  double us_per_tick = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+  bool first = true;
+  fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  for (int t = 0; t < TRACE_THREAD_COUNT; t++) {
+    fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", first ? "" : ",\n", t, thread_names[t]);
+    first = false;
+
+    // Snapshot the ring, then drop anything the producer may have overwritten while we copied
+    TraceRing *ring = &s->trace.rings[t];
+    unsigned int head = (unsigned int)SDL_GetAtomicInt(&ring->head);
+    SDL_MemoryBarrierAcquire();
+    unsigned int count = head < TRACE_RING_CAPACITY ? head : TRACE_RING_CAPACITY;
+    unsigned int start = head - count;
+    for (unsigned int i = 0; i < count; i++) copy[i] = ring->events[(start + i) & (TRACE_RING_CAPACITY - 1)];
+    SDL_MemoryBarrierAcquire();
+    unsigned int head_after = (unsigned int)SDL_GetAtomicInt(&ring->head);
+    // A full ring's oldest slot is also the one the producer fills next, before it publishes head,
+    // so copy[0] may be torn even when head has not moved
+    unsigned int skip = head_after - head + (count == TRACE_RING_CAPACITY ? 1 : 0);
+    if (skip > count) skip = count;
+
+    for (unsigned int i = skip; i < count; i++) {
+      TraceEvent *e = &copy[i];
+      double ts = (double)(Sint64)(e->ts - s->trace.base_counter) * us_per_tick;
+      fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":1,\"tid\":%d%s}", e->name, e->phase, ts, t, e->phase == 'i' ? ",\"s\":\"t\"" : "");
+    }
+  }
+  fprintf(f, "\n]}\n");
+
+  SDL_free(copy);
+  fclose(f);
+  return true;
+}
@@ -70,9 +70,9 @@ void UI_DrawHUD(AppState *s) {
 
     int mothership_idx = -1;
     for (int i = 0; i < MAX_UNITS; i++) {
-        if (s->world.units.active[i] && s->selection.unit_selected[i]) {
+        if (Bits_Test(s->world.units.active, i) && Bits_Test(s->selection.unit_selected, i)) {
             if (!any_selected) {
-                primary_behavior = s->world.units.behavior[i];
+                primary_behavior = s->world.orders.behavior[i];
                 any_selected = true;
             }
             if (s->world.units.type[i] == UNIT_MOTHERSHIP) {
@@ -107,19 +107,18 @@ void UI_DrawHUD(AppState *s) {
     int n_miners = 0, n_fighters = 0, n_all = 0;
     bool miners_sel = false, fighters_sel = false, all_sel = false;
     
-    for (int i = 0; i < MAX_UNITS; i++) {
-        if (!s->world.units.active[i]) continue;
+    BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) {
         if (s->world.units.type[i] == UNIT_MINER) { 
             n_miners++; n_all++; 
-            if (s->selection.unit_selected[i]) { miners_sel = true; all_sel = true; }
+            if (Bits_Test(s->selection.unit_selected, i)) { miners_sel = true; all_sel = true; }
         }
         else if (s->world.units.type[i] == UNIT_FIGHTER) { 
             n_fighters++; n_all++; 
-            if (s->selection.unit_selected[i]) { fighters_sel = true; all_sel = true; }
+            if (Bits_Test(s->selection.unit_selected, i)) { fighters_sel = true; all_sel = true; }
         }
         else {
             n_all++;
-            if (s->selection.unit_selected[i]) all_sel = true;
+            if (Bits_Test(s->selection.unit_selected, i)) all_sel = true;
         }
     }
     groups[0] = (typeof(groups[0])){ "F1", s->textures.miner_texture, n_miners, miners_sel };
@@ -159,7 +158,7 @@ void UI_DrawHUD(AppState *s) {
     float gy = wh - card_h - 20.0f;
 
     // --- Production Queue / Toggle Display ---
-    if (mothership_idx != -1 && s->world.units.production_mode[mothership_idx] != UNIT_TYPE_COUNT) {
+    if (mothership_idx != -1 && s->world.production.mode[mothership_idx] != UNIT_TYPE_COUNT) {
         float queue_x = 20.0f;
         float unit_icon_sz_q = 40.0f;
         float queue_y = gy - 30.0f - unit_icon_sz_q; // Above command card
@@ -167,7 +166,7 @@ void UI_DrawHUD(AppState *s) {
         SDL_SetRenderDrawColor(s->renderer, 200, 200, 200, 255);
         SDL_RenderDebugText(s->renderer, queue_x, queue_y - 15.0f, "AUTO PRODUCTION ACTIVE");
 
-        UnitType ut = s->world.units.production_mode[mothership_idx];
+        UnitType ut = s->world.production.mode[mothership_idx];
         SDL_Texture *tex = (ut == UNIT_MINER) ? s->textures.miner_texture : s->textures.fighter_texture;
         
         SDL_FRect r = {queue_x, queue_y, unit_icon_sz_q, unit_icon_sz_q};
@@ -176,7 +175,7 @@ void UI_DrawHUD(AppState *s) {
         if (tex) SDL_RenderTexture(s->renderer, tex, NULL, &r);
         
         float total = s->world.unit_stats[ut].production_time;
-        float current = s->world.units.production_timer[mothership_idx];
+        float current = s->world.production.timer[mothership_idx];
         float pct = current / total;
         SDL_SetRenderDrawColor(s->renderer, 0, 255, 0, 150);
         SDL_FRect pr = {queue_x, queue_y + unit_icon_sz_q, unit_icon_sz_q * pct, 4};
@@ -207,7 +206,7 @@ void UI_DrawHUD(AppState *s) {
         
         if (has_mothership) {
             float m_cd_pct = 0, m_cd_val = 0;
-            for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MOTHERSHIP) { m_cd_pct = s->world.units.large_cannon_cooldown[i] / s->world.units.stats[i]->main_cannon_cooldown; m_cd_val = s->world.units.large_cannon_cooldown[i]; break; }
+            BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP) { m_cd_pct = s->world.targets.large_cooldown[i] / s->world.units.stats[i]->main_cannon_cooldown; m_cd_val = s->world.targets.large_cooldown[i]; break; }
             buttons[10] = (typeof(buttons[0])){ "Y", "MAIN C", s->textures.icon_textures[ICON_MAIN_CANNON], false, s->input.key_y_down, 2, 0, m_cd_pct, m_cd_val };
             buttons[11] = (typeof(buttons[0])){ "X", "BUILD", s->textures.miner_texture, false, s->input.key_x_down, 2, 1 };
         }
@@ -219,7 +218,7 @@ void UI_DrawHUD(AppState *s) {
     } else if (s->ui.menu_state == 1) {
         if (has_mothership) {
             UnitType active_mode = UNIT_TYPE_COUNT;
-            for (int i = 0; i < MAX_UNITS; i++) if (s->world.units.active[i] && s->world.units.type[i] == UNIT_MOTHERSHIP && s->selection.unit_selected[i]) { active_mode = s->world.units.production_mode[i]; break; }
+            BITS_FOR_EACH(i, s->world.units.active, MAX_UNITS) if (s->world.units.type[i] == UNIT_MOTHERSHIP && Bits_Test(s->selection.unit_selected, i)) { active_mode = s->world.production.mode[i]; break; }
             buttons[0] = (typeof(buttons[0])){ "Q", "TGL MINR", s->textures.miner_texture, active_mode == UNIT_MINER, s->input.key_q_down, 0, 0 };
             buttons[1] = (typeof(buttons[0])){ "W", "TGL FGHT", s->textures.fighter_texture, active_mode == UNIT_FIGHTER, s->input.key_w_down, 0, 1 };
             buttons[10] = (typeof(buttons[0])){ "Y", "BACK", s->textures.icon_textures[ICON_BACK], false, s->input.key_y_down, 2, 0 };
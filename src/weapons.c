@@ -2,12 +2,17 @@
 #include "game.h"
 #include "constants.h"
 #include "particles.h"
-#include "physics.h"
 #include "utils.h"
+#include "rng.h"
+#include "commands.h"
+#include "slots.h"
 #include <math.h>
 #include <stdlib.h>
 
 void Weapons_Fire(AppState *s, int u_idx, int asteroid_idx, float damage, float energy_cost, bool is_main_cannon) {
+    // Already queued for destruction; the slot is freed at the next flush
+    if (Commands_DestroyPending(s, asteroid_idx)) return;
+
     if (is_main_cannon) {
         // Main cannon is free (uses cooldown)
     } else {
@@ -25,39 +30,16 @@ void Weapons_Fire(AppState *s, int u_idx, int asteroid_idx, float damage, float
     s->world.asteroids.radius[asteroid_idx] -= (damage / ASTEROID_HEALTH_MULT) * 0.2f;
     if (s->world.asteroids.health[asteroid_idx] <= 0 || s->world.asteroids.radius[asteroid_idx] < ASTEROID_MIN_RADIUS) {
         Vec2 pos = s->world.asteroids.pos[asteroid_idx];
-        float rad = s->world.asteroids.radius[asteroid_idx];
-        int tex = s->world.asteroids.tex_idx[asteroid_idx];
-        
-        s->world.asteroids.active[asteroid_idx] = false;
-        s->world.asteroid_count--;
-        Particles_SpawnExplosion(s, pos, 40, s->world.asteroids.max_health[asteroid_idx] / 1000.0f, EXPLOSION_COLLISION, tex);
+        // Removal, crystal and blast land at the next flush, after the unit loop
+        Commands_DestroyAsteroid(s, asteroid_idx, false);
 
         // Spawn Crystal on destruction
-        if (((float)rand() / (float)RAND_MAX) < 0.3f) { // 30% chance
-            float c_rad = CRYSTAL_RADIUS_SMALL_MIN + ((float)rand() / (float)RAND_MAX) * CRYSTAL_RADIUS_SMALL_VARIANCE;
-            float angle = ((float)rand() / (float)RAND_MAX) * 2.0f * 3.14159f;
-            SpawnCrystal(s, pos, (Vec2){cosf(angle), sinf(angle)}, c_rad);
-
-            // Explosion damage area around crystal spawn
-            float blast_radius = c_rad * 2.0f;
-            float blast_damage = c_rad * 5.0f; // Scale damage with crystal size
-            
-            // Damage Units
-            for (int u = 0; u < MAX_UNITS; u++) {
-                if (!s->world.units.active[u]) continue;
-                float dsq = Vector_DistanceSq(pos, s->world.units.pos[u]);
-                if (dsq < blast_radius * blast_radius) {
-                    s->world.units.health[u] -= blast_damage * 0.5f; // Units take half damage
-                }
-            }
-            // Damage other Asteroids
-            for (int a = 0; a < MAX_ASTEROIDS; a++) {
-                if (!s->world.asteroids.active[a] || a == asteroid_idx) continue;
-                float dsq = Vector_DistanceSq(pos, s->world.asteroids.pos[a]);
-                if (dsq < blast_radius * blast_radius) {
-                    s->world.asteroids.health[a] -= blast_damage;
-                }
-            }
+        if (Rng_Float(&s->world.rng_sim) < 0.3f) { // 30% chance
+            float c_rad = CRYSTAL_RADIUS_SMALL_MIN + Rng_Float(&s->world.rng_sim) * CRYSTAL_RADIUS_SMALL_VARIANCE;
+            float angle = Rng_Float(&s->world.rng_sim) * 2.0f * 3.14159f;
+            Commands_SpawnCrystal(s, pos, (Vec2){cosf(angle), sinf(angle)}, c_rad);
+            // Explosion damage around the crystal spawn, scaled with crystal size; units take half
+            Commands_FlatDamage(s, pos, c_rad * 2.0f, c_rad * 5.0f, 0.5f, 1.0f, asteroid_idx);
         }
     }
     
@@ -76,16 +58,14 @@ void Weapons_Fire(AppState *s, int u_idx, int asteroid_idx, float damage, float
         impact_pos.y -= (dy / dist) * ast_r;
     }
 
-    int p_idx = s->world.particle_next_idx;
-    s->world.particles.active[p_idx] = true;
+    int p_idx = Particles_Alloc(s);
     s->world.particles.type[p_idx] = PARTICLE_TRACER;
-    s->world.particles.pos[p_idx] = start_pos;
-    s->world.particles.target_pos[p_idx] = impact_pos;
-    s->world.particles.unit_idx[p_idx] = u_idx;
+    Particles_SetPos(s, p_idx, start_pos);
+    s->world.tracers.target_pos[p_idx] = impact_pos;
+    s->world.tracers.unit_idx[p_idx] = u_idx;
     s->world.particles.life[p_idx] = 1.0f; 
     s->world.particles.size[p_idx] = 1.0f + (damage / 50.0f);
     s->world.particles.color[p_idx] = (SDL_Color)COLOR_LASER_RED; 
-    s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
 
     // Muzzle flash
     Particles_SpawnLaserFlash(s, start_pos, s->world.particles.size[p_idx], (SDL_Color)COLOR_LASER_RED, false);
@@ -102,26 +82,25 @@ void Weapons_MineCrystal(AppState *s, int u_idx, int resource_idx, float amount)
     s->world.resources.health[resource_idx] -= amount;
     
     // Chance to split during mining
-    if (s->world.resources.radius[resource_idx] > CRYSTAL_SPLIT_THRESHOLD && ((float)rand() / (float)RAND_MAX) < 0.005f) { // 0.5% chance per tick
+    if (s->world.resources.radius[resource_idx] > CRYSTAL_SPLIT_THRESHOLD && Rng_Float(&s->world.rng_sim) < 0.005f) { // 0.5% chance per tick
         Vec2 pos = s->world.resources.pos[resource_idx];
         Vec2 old_vel = s->world.resources.velocity[resource_idx];
         float old_rad = s->world.resources.radius[resource_idx];
         float new_rad = old_rad * 0.6f;
         
-        s->world.resources.active[resource_idx] = false;
-        s->world.resource_count--;
+        Slots_FreeResource(s, resource_idx);
         
         // Explosion & Area Damage
         Particles_SpawnExplosion(s, pos, 30, 1.2f, EXPLOSION_COLLISION, 0);
-        Physics_AreaDamage(s, pos, old_rad * 3.5f, old_rad * 2.5f, -1);
+        Commands_AreaDamage(s, pos, old_rad * 3.5f, old_rad * 2.5f, -1);
         
         // Spawn two smaller fragments with increased velocity
         for (int f = 0; f < 2; f++) {
-            float angle = ((float)rand() / (float)RAND_MAX) * 2.0f * 3.14159f;
+            float angle = Rng_Float(&s->world.rng_sim) * 2.0f * 3.14159f;
             Vec2 off = {cosf(angle) * new_rad, sinf(angle) * new_rad};
             // New velocity is old velocity + outward blast
             Vec2 f_vel_dir = Vector_Normalize(Vector_Add(old_vel, Vector_Scale(Vector_Normalize(off), 200.0f)));
-            SpawnCrystal(s, Vector_Add(pos, off), f_vel_dir, new_rad);
+            Commands_SpawnCrystal(s, Vector_Add(pos, off), f_vel_dir, new_rad);
         }
         return; // Crystal is gone
     }
@@ -134,21 +113,18 @@ void Weapons_MineCrystal(AppState *s, int u_idx, int resource_idx, float amount)
     if (s->world.resources.health[resource_idx] <= 0) {
         // Resource depleted
         Vec2 pos = s->world.resources.pos[resource_idx];
-        s->world.resources.active[resource_idx] = false;
-        s->world.resource_count--;
+        Slots_FreeResource(s, resource_idx);
         
         // Final big explosion
         Particles_SpawnExplosion(s, pos, 30, 1.5f, EXPLOSION_COLLISION, 0); 
         // Use a bright cyan/white shockwave for crystals
-        int sw_idx = s->world.particle_next_idx;
-        s->world.particles.active[sw_idx] = true;
+        int sw_idx = Particles_Alloc(s);
         s->world.particles.type[sw_idx] = PARTICLE_SHOCKWAVE;
-        s->world.particles.pos[sw_idx] = pos;
-        s->world.particles.velocity[sw_idx] = (Vec2){0,0};
+        Particles_SetPos(s, sw_idx, pos);
+        Particles_SetVelocity(s, sw_idx, (Vec2){0,0});
         s->world.particles.life[sw_idx] = 0.6f;
         s->world.particles.size[sw_idx] = 100.0f;
         s->world.particles.color[sw_idx] = (SDL_Color){100, 255, 255, 255};
-        s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
     }
 
     float dx = s->world.resources.pos[resource_idx].x - s->world.units.pos[u_idx].x;
@@ -166,16 +142,14 @@ void Weapons_MineCrystal(AppState *s, int u_idx, int resource_idx, float amount)
         impact_pos.y -= (dy / dist) * res_r;
     }
 
-    int p_idx = s->world.particle_next_idx;
-    s->world.particles.active[p_idx] = true;
+    int p_idx = Particles_Alloc(s);
     s->world.particles.type[p_idx] = PARTICLE_TRACER;
-    s->world.particles.pos[p_idx] = start_pos;
-    s->world.particles.target_pos[p_idx] = impact_pos;
-    s->world.particles.unit_idx[p_idx] = u_idx;
+    Particles_SetPos(s, p_idx, start_pos);
+    s->world.tracers.target_pos[p_idx] = impact_pos;
+    s->world.tracers.unit_idx[p_idx] = u_idx;
     s->world.particles.life[p_idx] = 0.5f; // Shorter life for continuous beam look
     s->world.particles.size[p_idx] = 6.0f; // Increased width
     s->world.particles.color[p_idx] = (SDL_Color){50, 255, 200, 255}; // Cyan mining laser
-    s->world.particle_next_idx = (s->world.particle_next_idx + 1) % MAX_PARTICLES;
 
     SDL_Color mining_color = {50, 255, 200, 255};
     Particles_SpawnLaserFlash(s, start_pos, 2.0f, mining_color, false);
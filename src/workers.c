@@ -1,6 +1,7 @@
 #include "workers.h"
 #include "constants.h"
 #include "utils.h"
+#include "trace.h"
 #include <math.h>
 
 typedef struct {
@@ -27,6 +28,7 @@ static int SDLCALL BackgroundGenerationThread(void *data) {
   AppState *s = (AppState *)data;
   while (SDL_GetAtomicInt(&s->threads.bg_should_quit) == 0) {
     if (SDL_GetAtomicInt(&s->threads.bg_request_update) == 1) {
+      Trace_Begin(s, TRACE_THREAD_BACKGROUND, "bg_generate");
       SDL_LockMutex(s->threads.bg_mutex); Vec2 cam_pos = s->threads.bg_target_cam_pos; float zoom = s->threads.bg_target_zoom, time = s->threads.bg_target_time; SDL_UnlockMutex(s->threads.bg_mutex);
       for (int i = 0; i < s->textures.bg_w * s->textures.bg_h; i++) {
         int x = i % s->textures.bg_w, y = i / s->textures.bg_w; float wx = cam_pos.x + (x * BG_SCALE_FACTOR) / zoom, wy = cam_pos.y + (y * BG_SCALE_FACTOR) / zoom;
@@ -38,6 +40,7 @@ static int SDLCALL BackgroundGenerationThread(void *data) {
         s->threads.bg_pixel_buffer[i] = (a << 24) | (b << 16) | (g << 8) | r;
       }
       SDL_SetAtomicInt(&s->threads.bg_request_update, 0); SDL_SetAtomicInt(&s->threads.bg_data_ready, 1);
+      Trace_End(s, TRACE_THREAD_BACKGROUND, "bg_generate");
     } else SDL_Delay(10);
   }
   return 0;
@@ -47,6 +50,7 @@ static int SDLCALL DensityGenerationThread(void *data) {
   AppState *s = (AppState *)data;
   while (SDL_GetAtomicInt(&s->threads.density_should_quit) == 0) {
     if (SDL_GetAtomicInt(&s->threads.density_request_update) == 1) {
+      Trace_Begin(s, TRACE_THREAD_DENSITY, "density_generate");
       SDL_LockMutex(s->threads.density_mutex); Vec2 cam_pos = s->threads.density_target_cam_pos; SDL_UnlockMutex(s->threads.density_mutex);
       float range = MINIMAP_RANGE, start_x = cam_pos.x - range / 2.0f, start_y = cam_pos.y - range / 2.0f, cell_sz = (float)DENSITY_CELL_SIZE / (float)GRID_DENSITY_SUB_RES;
       for (int i = 0; i < s->threads.density_w * s->threads.density_h; i++) {
@@ -54,6 +58,7 @@ static int SDLCALL DensityGenerationThread(void *data) {
           s->threads.density_pixel_buffer[i] = (d > 0.01f) ? (((Uint8)fminf(40.0f, d * 60.0f + 5.0f)) << 24) | ((Uint8)fminf(255.0f, d * 255.0f)) : 0;
       }
       SDL_SetAtomicInt(&s->threads.density_request_update, 0); SDL_SetAtomicInt(&s->threads.density_data_ready, 1);
+      Trace_End(s, TRACE_THREAD_DENSITY, "density_generate");
     } else SDL_Delay(20);
   }
   return 0;
@@ -74,10 +79,12 @@ void Workers_UpdateBackground(AppState *s) {
       SDL_UnlockTexture(s->textures.bg_texture);
     }
     SDL_SetAtomicInt(&s->threads.bg_data_ready, 0);
+    Trace_Instant(s, TRACE_THREAD_MAIN, "bg_uploaded");
   }
   if (SDL_GetAtomicInt(&s->threads.bg_request_update) == 0) {
     SDL_LockMutex(s->threads.bg_mutex); s->threads.bg_target_cam_pos = s->camera.pos; s->threads.bg_target_zoom = s->camera.zoom; s->threads.bg_target_time = s->current_time; SDL_UnlockMutex(s->threads.bg_mutex);
     SDL_SetAtomicInt(&s->threads.bg_request_update, 1);
+    Trace_Instant(s, TRACE_THREAD_MAIN, "bg_requested");
   }
 }
 
@@ -91,6 +98,7 @@ void Workers_UpdateDensityMap(AppState *s) {
       SDL_LockMutex(s->threads.density_mutex); s->threads.density_texture_cam_pos = s->threads.density_target_cam_pos; SDL_UnlockMutex(s->threads.density_mutex);
     }
     SDL_SetAtomicInt(&s->threads.density_data_ready, 0);
+    Trace_Instant(s, TRACE_THREAD_MAIN, "density_uploaded");
   }
   if (SDL_GetAtomicInt(&s->threads.density_request_update) == 0) {
     int ww, wh; SDL_GetRenderOutputSize(s->renderer, &ww, &wh);
@@ -99,5 +107,6 @@ void Workers_UpdateDensityMap(AppState *s) {
     float cell_sz = (float)DENSITY_CELL_SIZE / (float)GRID_DENSITY_SUB_RES;
     SDL_LockMutex(s->threads.density_mutex); s->threads.density_target_cam_pos.x = floorf(cx / cell_sz) * cell_sz; s->threads.density_target_cam_pos.y = floorf(cy / cell_sz) * cell_sz; SDL_UnlockMutex(s->threads.density_mutex);
     SDL_SetAtomicInt(&s->threads.density_request_update, 1);
+    Trace_Instant(s, TRACE_THREAD_MAIN, "density_requested");
   }
 }